@@ -1,9 +1,14 @@
 #include "Analyzer.h"
 
+#include <atomic>
+#include <thread>
+
 #include "Error.h"
 #include "Logger.h"
 #include "AnalyzerScope.h"
+#include "Module/BlobSpecializations.h"
 #include "Module/Module.h"
+#include "Module/ModuleReachability.h"
 #include "Parser/ValueType.h"
 
 #include "Parser/Expression/Expression.h"
@@ -39,30 +44,74 @@
 #include "Parser/Statement/StatementVariable.h"
 #include "Parser/Statement/StatementVariableDeclaration.h"
 
-Analyzer::Analyzer(shared_ptr<Module> module, map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap) :
-module(module), importableHeaderStatementsMap(importableHeaderStatementsMap) { }
+Analyzer::Analyzer(
+    shared_ptr<Module> module,
+    map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap,
+    shared_ptr<map<string, shared_ptr<AnalyzerScope>>> importedScopesMap,
+    shared_ptr<ModuleReachability> reachability,
+    shared_ptr<BlobSpecializations> blobSpecializations,
+    int jobsCount
+) :
+module(module), importableHeaderStatementsMap(importableHeaderStatementsMap), importedScopesMap(importedScopesMap), reachability(reachability), blobSpecializations(blobSpecializations), jobsCount(jobsCount) { }
 
 void Analyzer::checkModule() {
     scope = make_shared<AnalyzerScope>();
 
     // check header
-    for (shared_ptr<Statement> statement : module->getHeaderStatements())
+    for (shared_ptr<Statement> statement : module->getHeaderStatements()) {
+        // globals are always zero initialized
+        shared_ptr<StatementVariable> statementVariable = dynamic_pointer_cast<StatementVariable>(statement);
+        if (statementVariable != nullptr && statementVariable->getIsUninitialized())
+            markErrorInvalidAttribute(statementVariable->getLocation(), "@uninit");
+
         checkStatement(statement, nullptr);
+    }
+
+    // protos which are not exported and are implemented by a single blob can be always called directly
+    for (shared_ptr<Statement> statement : module->getHeaderStatements()) {
+        shared_ptr<StatementProto> statementProto = dynamic_pointer_cast<StatementProto>(statement);
+        if (statementProto == nullptr || statementProto->getShouldExport())
+            continue;
+
+        vector<string> blobNames;
+        for (shared_ptr<Statement> headerStatement : module->getHeaderStatements()) {
+            shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(headerStatement);
+            if (statementBlob == nullptr)
+                continue;
+            vector<string> protoNames = statementBlob->getProtoNames();
+            if (find(protoNames.begin(), protoNames.end(), statementProto->getName()) != protoNames.end())
+                blobNames.push_back(statementBlob->getName());
+        }
+        if (blobNames.size() == 1)
+            singleProtoBlobNamesMap[statementProto->getName()] = blobNames.front();
+    }
+
+    // check body statements other than functions
+    for (shared_ptr<Statement> statement : module->getBodyStatements()) {
+        if (statement->getKind() != StatementKind::FUNCTION)
+            checkStatement(statement, nullptr);
+    }
 
-    // check blob member functions
+    // check signatures of blob member functions and body functions
+    vector<shared_ptr<StatementFunction>> statementFunctions;
     for (shared_ptr<Statement> headerStatement : module->getHeaderStatements()) {
         if (shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(headerStatement)) {
             for (shared_ptr<StatementFunction> statementFunction : statementBlob->getFunctionStatements()) {
-                checkStatement(statementFunction);
+                if (isReachable(statementFunction) && checkFunctionSignature(statementFunction))
+                    statementFunctions.push_back(statementFunction);
             }
         }
     }
 
-    // check body
     for (shared_ptr<Statement> statement : module->getBodyStatements()) {
-            checkStatement(statement, nullptr);
+        shared_ptr<StatementFunction> statementFunction = dynamic_pointer_cast<StatementFunction>(statement);
+        if (statementFunction != nullptr && isReachable(statementFunction) && checkFunctionSignature(statementFunction))
+            statementFunctions.push_back(statementFunction);
     }
 
+    // and then their bodies
+    checkFunctionBodies(statementFunctions);
+
     if (!errors.empty()) {
         for (shared_ptr<Error> &error : errors)
             Logger::print(error);
@@ -70,6 +119,130 @@ void Analyzer::checkModule() {
     }
 }
 
+void Analyzer::checkFunctionBodies(vector<shared_ptr<StatementFunction>> statementFunctions) {
+    // types of the declarations are shared between the workers, so they are only read from now on
+    resolveSharedValueTypes(module->getHeaderStatements());
+    resolveSharedValueTypes(module->getBodyStatements());
+
+    // module scope is shared between the workers, so it cannot change anymore
+    scope->freeze();
+
+    vector<vector<shared_ptr<Error>>> functionsErrors(statementFunctions.size());
+    atomic<int> nextFunctionIndex = 0;
+
+    auto worker = [&]() {
+        // each worker has its own local scope on top of the module scope
+        Analyzer workerAnalyzer = *this;
+        workerAnalyzer.scope = make_shared<AnalyzerScope>();
+        workerAnalyzer.scope->attachImportedScope(scope);
+
+        int index;
+        while ((index = nextFunctionIndex++) < statementFunctions.size()) {
+            workerAnalyzer.errors.clear();
+            workerAnalyzer.checkFunctionBody(statementFunctions.at(index));
+            functionsErrors.at(index) = workerAnalyzer.errors;
+        }
+    };
+
+    int workersCount = min(jobsCount, (int)statementFunctions.size());
+    vector<thread> threads;
+    for (int i=1; i<workersCount; i++)
+        threads.push_back(thread(worker));
+    worker();
+    for (thread &workerThread : threads)
+        workerThread.join();
+
+    // merge errors in the order of the functions
+    for (vector<shared_ptr<Error>> &functionErrors : functionsErrors)
+        errors.insert(errors.end(), functionErrors.begin(), functionErrors.end());
+}
+
+void Analyzer::resolveSharedValueTypes(vector<shared_ptr<Statement>> statements) {
+    for (shared_ptr<Statement> &statement : statements) {
+        switch (statement->getKind()) {
+            case StatementKind::BLOB: {
+                shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(statement);
+                for (shared_ptr<StatementVariable> &statementVariable : statementBlob->getVariableStatements())
+                    resolveSharedValueType(statementVariable->getValueType());
+                for (shared_ptr<StatementFunction> &statementFunction : statementBlob->getFunctionStatements()) {
+                    if (isReachable(statementFunction))
+                        resolveSharedValueType(statementFunction->getValueType());
+                }
+                break;
+            }
+            case StatementKind::PROTO: {
+                shared_ptr<StatementProto> statementProto = dynamic_pointer_cast<StatementProto>(statement);
+                for (shared_ptr<StatementVariable> &statementVariable : statementProto->getVariableStatements())
+                    resolveSharedValueType(statementVariable->getValueType());
+                for (shared_ptr<StatementFunctionDeclaration> &statementFunctionDeclaration : statementProto->getFunctionDeclarationStatements())
+                    resolveSharedValueType(statementFunctionDeclaration->getValueType());
+                break;
+            }
+            case StatementKind::FUNCTION: {
+                shared_ptr<StatementFunction> statementFunction = dynamic_pointer_cast<StatementFunction>(statement);
+                if (isReachable(statementFunction))
+                    resolveSharedValueType(statementFunction->getValueType());
+                break;
+            }
+            case StatementKind::FUNCTION_DECLARATION:
+                resolveSharedValueType(dynamic_pointer_cast<StatementFunctionDeclaration>(statement)->getValueType());
+                break;
+            case StatementKind::VARIABLE:
+                resolveSharedValueType(dynamic_pointer_cast<StatementVariable>(statement)->getValueType());
+                break;
+            case StatementKind::VARIABLE_DECLARATION:
+                resolveSharedValueType(dynamic_pointer_cast<StatementVariableDeclaration>(statement)->getValueType());
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void Analyzer::resolveSharedValueType(shared_ptr<ValueType> valueType) {
+    if (valueType == nullptr)
+        return;
+
+    switch (valueType->getKind()) {
+        case ValueTypeKind::BLOB: {
+            if (!valueType->namedTypeKeys)
+                valueType->namedTypeKeys = scope->getBlobNamedTypeKeys(*valueType->getBlobName());
+            optional<vector<shared_ptr<ValueType>>> namedTypeValues = valueType->getNamedTypeValues();
+            if (namedTypeValues) {
+                for (shared_ptr<ValueType> &namedTypeValue : *namedTypeValues)
+                    resolveSharedValueType(namedTypeValue);
+            }
+            break;
+        }
+        case ValueTypeKind::DATA:
+        case ValueTypeKind::VEC: {
+            shared_ptr<Expression> countExpression = valueType->getCountExpression();
+            if (countExpression != nullptr && countExpression->getValueType() == nullptr)
+                countExpression->valueType = typeForExpression(countExpression, nullptr, nullptr);
+            resolveSharedValueType(valueType->getSubType());
+            break;
+        }
+        case ValueTypeKind::BOXED:
+        case ValueTypeKind::PTR:
+            resolveSharedValueType(valueType->getSubType());
+            break;
+        case ValueTypeKind::FUN: {
+            vector<shared_ptr<ValueType>> argumentTypes = *valueType->getArgumentTypes();
+            for (shared_ptr<ValueType> &argumentType : argumentTypes)
+                resolveSharedValueType(argumentType);
+            resolveSharedValueType(valueType->getReturnType());
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool Analyzer::isReachable(shared_ptr<StatementFunction> statementFunction) {
+    // everything is reachable if not compiling lazily
+    return reachability == nullptr || reachability->isFunctionReachable(statementFunction->getName());
+}
+
 //
 // Statements
 //
@@ -91,13 +264,17 @@ void Analyzer::checkStatement(shared_ptr<Statement> statement, shared_ptr<ValueT
             checkStatement(dynamic_pointer_cast<StatementExpression>(statement), returnType);
             break;
         case StatementKind::FUNCTION:
-            checkStatement(dynamic_pointer_cast<StatementFunction>(statement));
+            // imported bodies have already been checked by their own module
+            if (!isImported)
+                checkStatement(dynamic_pointer_cast<StatementFunction>(statement));
             break;
         case StatementKind::FUNCTION_DECLARATION:
             checkStatement(dynamic_pointer_cast<StatementFunctionDeclaration>(statement));
             break;
         case StatementKind::META_EXTERN_FUNCTION:
-            checkStatement(dynamic_pointer_cast<StatementMetaExternFunction>(statement));
+            // only used by the imported bodies
+            if (!isImported)
+                checkStatement(dynamic_pointer_cast<StatementMetaExternFunction>(statement));
             break;
         case StatementKind::META_EXTERN_VARIABLE:
             checkStatement(dynamic_pointer_cast<StatementMetaExternVariable>(statement));
@@ -135,6 +312,36 @@ void Analyzer::checkStatement(shared_ptr<StatementAssignment> statementAssignmen
     shared_ptr<ValueType> targetType = typeForExpression(statementAssignment->getExpressionChained());
     if (targetType == nullptr)
         return;
+
+    // arguments passed by reference and constants are read-only
+    shared_ptr<ExpressionValue> rootExpressionValue = dynamic_pointer_cast<ExpressionValue>(statementAssignment->getExpressionChained()->getChainExpressions().front());
+    if (rootExpressionValue != nullptr) {
+        shared_ptr<ValueType> rootType = scope->getVariableType(rootExpressionValue->getIdentifier());
+        if (rootType != nullptr && rootType->isReference()) {
+            markErrorReadOnly(rootExpressionValue->getLocation(), rootExpressionValue->getIdentifier());
+            return;
+        }
+    }
+
+    // @pure functions can only modify their own variables, module variables are already rejected when read
+    if (isCheckingPureFunction) {
+        vector<shared_ptr<Expression>> chainExpressions = statementAssignment->getExpressionChained()->getChainExpressions();
+        for (int i=0; i<chainExpressions.size(); i++) {
+            shared_ptr<ExpressionValue> expressionValue = dynamic_pointer_cast<ExpressionValue>(chainExpressions.at(i));
+            if (expressionValue == nullptr)
+                continue;
+
+            // written through a pointer
+            bool isBlobIt = i == 0 && expressionValue->getIdentifier().compare("it") == 0;
+            bool isPointee = expressionValue->getValueKind() == ExpressionValueKind::BUILT_IN_VAL_SIMPLE || expressionValue->getValueKind() == ExpressionValueKind::BUILT_IN_VAL_DATA;
+            bool isProtoMember = i > 0 && chainExpressions.at(i-1)->getValueType() != nullptr && chainExpressions.at(i-1)->getValueType()->isProto();
+            if (isBlobIt || isPointee || isProtoMember) {
+                string name = rootExpressionValue != nullptr ? rootExpressionValue->getIdentifier() : expressionValue->getIdentifier();
+                markErrorNotPure(statementAssignment->getLocation(), name);
+                return;
+            }
+        }
+    }
     targetType = resolvedAndCheckedValueType(targetType, false, statementAssignment->getLocation());
     statementAssignment->valueExpression = checkAndTryCasting(statementAssignment->getValueExpression(), targetType, nullptr);
     if (statementAssignment->getValueExpression() == nullptr)
@@ -148,6 +355,11 @@ void Analyzer::checkStatement(shared_ptr<StatementAssignment> statementAssignmen
             targetType
         );
     }
+
+    // keep track of blobs assigned to proto variables
+    bool isVariable = statementAssignment->getExpressionChained()->getChainExpressions().size() == 1 && rootExpressionValue != nullptr && rootExpressionValue->getIndexExpression() == nullptr;
+    if (targetType != nullptr && targetType->isProto() && isVariable)
+        trackProtoAssignment(rootExpressionValue->getIdentifier(), statementAssignment->getValueExpression());
 }
 
 void Analyzer::checkStatement(shared_ptr<StatementBlob> statementBlob, bool isImported) {
@@ -174,6 +386,24 @@ void Analyzer::checkStatement(shared_ptr<StatementBlob> statementBlob, bool isIm
             markErrorInvalidAttribute(statementVariable->getLocation(), "@export");
             return;
         }
+
+        // or @uninit
+        if (statementVariable->getIsUninitialized()) {
+            markErrorInvalidAttribute(statementVariable->getLocation(), "@uninit");
+            return;
+        }
+
+        // or @const
+        if (statementVariable->getIsConstant()) {
+            markErrorInvalidAttribute(statementVariable->getLocation(), "@const");
+            return;
+        }
+
+        // or @align
+        if (statementVariable->getAlignment()) {
+            markErrorInvalidAttribute(statementVariable->getLocation(), "@align");
+            return;
+        }
         checkStatement(statementVariable);
     }
 
@@ -291,27 +521,62 @@ void Analyzer::checkStatement(shared_ptr<StatementExpression> statementExpressio
 }
 
 void Analyzer::checkStatement(shared_ptr<StatementFunction> statementFunction) {
+    if (checkFunctionSignature(statementFunction))
+        checkFunctionBody(statementFunction);
+}
+
+bool Analyzer::checkFunctionSignature(shared_ptr<StatementFunction> statementFunction) {
     // check argument types
     for (pair<string, shared_ptr<ValueType>> &argument : statementFunction->getArguments()) {
         if (resolvedAndCheckedValueType(argument.second, true, statementFunction->getLocation()) == nullptr)
-            return;
+            return false;
     }
 
     // update return type
     if (resolvedAndCheckedValueType(statementFunction->getReturnValueType(), true, statementFunction->getLocation()) == nullptr)
-        return;
+        return false;
+
+    // attributes which contradict each other
+    if (statementFunction->getShouldInline() && statementFunction->getIsNoInline())
+        markErrorInvalidAttribute(statementFunction->getLocation(), "@noinline");
+    if (statementFunction->getIsHot() && statementFunction->getIsCold())
+        markErrorInvalidAttribute(statementFunction->getLocation(), "@cold");
+
+    // only pointers can be marked as not overlapping
+    for (pair<string, shared_ptr<ValueType>> &argument : statementFunction->getArguments()) {
+        bool isNoAlias = statementFunction->getNoAliasArgumentNames().contains(argument.first);
+        if (isNoAlias && (argument.second->isReference() || !argument.second->isPointer()))
+            markErrorInvalidAttribute(statementFunction->getLocation(), "@noalias");
+    }
 
     // check if function is not yet defined and register it
     if (!scope->setFunctionType(statementFunction->getName(), statementFunction->getValueType(), true))
         markErrorAlreadyDefined(statementFunction->getLocation(), statementFunction->getName());
 
+    return true;
+}
+
+void Analyzer::checkFunctionBody(shared_ptr<StatementFunction> statementFunction) {
+    // won't be built, so there's nothing to check
+    if (!isReachable(statementFunction))
+        return;
+
+    protoBlobNamesMap.clear();
+    protoCalls.clear();
+    isCheckingPureFunction = statementFunction->getIsPure();
+
     scope->pushLevel();
     // register arguments as variables
-    for (auto &argument : statementFunction->getArguments())
+    for (auto &argument : statementFunction->getArguments()) {
         scope->setVariableType(argument.first, argument.second, true);
+        // can be any blob
+        protoBlobNamesMap[argument.first] = nullopt;
+    }
 
     checkStatement(statementFunction->getStatementBlock(), statementFunction->getReturnValueType());
     scope->popLevel();
+
+    devirtualizeProtoCalls();
 }
 
 void Analyzer::checkStatement(shared_ptr<StatementFunctionDeclaration> statementFunctionDeclaration) {
@@ -334,6 +599,10 @@ void Analyzer::checkStatement(shared_ptr<StatementFunctionDeclaration> statement
             nullptr
         );
     }
+
+    // can be called from other @pure functions
+    if (statementFunctionDeclaration->getIsPure())
+        scope->setFunctionPure(name);
 }
 
 void Analyzer::checkStatement(shared_ptr<StatementMetaExternFunction> statementMetaExternFunction) {
@@ -359,16 +628,50 @@ void Analyzer::checkStatement(shared_ptr<StatementMetaExternVariable> statementM
 }
 
 void Analyzer::checkStatement(shared_ptr<StatementMetaImport> statement) {
+    // exported header has already been checked, so just attach its scope
+    auto scopeIt = importedScopesMap->find(statement->getName());
+    if (scopeIt != importedScopesMap->end()) {
+        scope->attachImportedScope(scopeIt->second);
+        return;
+    }
+
     auto it = importableHeaderStatementsMap.find(statement->getName());
     if (it == importableHeaderStatementsMap.end()) {
         markErrorInvalidImport(statement->getLocation(), statement->getName());
         return;
     }
+
+    // already being checked further up
+    if (checkedImportNames.contains(statement->getName()))
+        return;
+    checkedImportNames.insert(statement->getName());
+
+    // check the exported header in its own scope, so it can be shared by all the importers
+    // header starts with its own imports, which get attached to that scope
+    shared_ptr<AnalyzerScope> moduleScope = scope;
+    scope = make_shared<AnalyzerScope>();
+    int errorsCount = errors.size();
+
+    string previousImportModulePrefix = importModulePrefix;
     importModulePrefix = statement->getName() + ".";
     for (shared_ptr<Statement> &importStatement : it->second) {
         checkStatement(importStatement, nullptr, true);
     }
-    importModulePrefix = "";
+    // importers check their function bodies in parallel
+    resolveSharedValueTypes(it->second);
+    importModulePrefix = previousImportModulePrefix;
+    checkedImportNames.erase(statement->getName());
+
+    shared_ptr<AnalyzerScope> importedScope = scope;
+    scope = moduleScope;
+
+    // don't share a scope of an invalid header
+    if (errors.size() > errorsCount)
+        return;
+
+    importedScope->freeze();
+    (*importedScopesMap)[statement->getName()] = importedScope;
+    scope->attachImportedScope(importedScope);
 }
 
 void Analyzer::checkStatement(shared_ptr<StatementProto> statement) {
@@ -387,6 +690,24 @@ void Analyzer::checkStatement(shared_ptr<StatementProto> statement) {
             return;
         }
 
+        // or @uninit
+        if (statementVariable->getIsUninitialized()) {
+            markErrorInvalidAttribute(statementVariable->getLocation(), "@uninit");
+            return;
+        }
+
+        // or @const
+        if (statementVariable->getIsConstant()) {
+            markErrorInvalidAttribute(statementVariable->getLocation(), "@const");
+            return;
+        }
+
+        // or @align
+        if (statementVariable->getAlignment()) {
+            markErrorInvalidAttribute(statementVariable->getLocation(), "@align");
+            return;
+        }
+
         checkStatement(statementVariable);
     }
     scope->popLevel();
@@ -443,6 +764,24 @@ void Analyzer::checkStatement(shared_ptr<StatementRawFunction> statementRawFunct
 }
 
 void Analyzer::checkStatement(shared_ptr<StatementRepeat> statementRepeat, shared_ptr<ValueType> returnType) {
+    // optimization hints
+    optional<int> unrollCount = statementRepeat->getUnrollCount();
+    if (unrollCount && *unrollCount < 1)
+        markErrorInvalidAttribute(statementRepeat->getLocation(), format("@unroll({})", *unrollCount));
+    if (unrollCount && statementRepeat->getIsNoUnroll())
+        markErrorInvalidAttribute(statementRepeat->getLocation(), "@nounroll");
+
+    // width has to be a power of two
+    optional<int> vectorizeWidth = statementRepeat->getVectorizeWidth();
+    optional<int> interleaveCount = statementRepeat->getInterleaveCount();
+    if (vectorizeWidth && (*vectorizeWidth < 1 || (*vectorizeWidth & (*vectorizeWidth - 1)) != 0 || (interleaveCount && *interleaveCount < 1)))
+        markErrorInvalidAttribute(statementRepeat->getLocation(), format("@vectorize({})", *vectorizeWidth));
+
+    // likelihood is about the condition, so there has to be one
+    optional<bool> isConditionLikely = statementRepeat->getIsConditionLikely();
+    if (isConditionLikely && statementRepeat->getPreConditionExpression() == nullptr && statementRepeat->getPostConditionExpression() == nullptr)
+        markErrorInvalidAttribute(statementRepeat->getLocation(), *isConditionLikely ? "@likely" : "@unlikely");
+
     scope->pushLevel();
     if (statementRepeat->getInitStatement() != nullptr)
         checkStatement(statementRepeat->getInitStatement(), returnType);
@@ -491,6 +830,19 @@ void Analyzer::checkStatement(shared_ptr<StatementVariable> statementVariable) {
     if (statementVariable->getValueType() == nullptr)
         return;
 
+    // uninitialized variables cannot have an initial value
+    if (statementVariable->getIsUninitialized() && (statementVariable->getExpression() != nullptr || statementVariable->getIsConstant())) {
+        markErrorInvalidAttribute(statementVariable->getLocation(), "@uninit");
+        return;
+    }
+
+    // alignment has to be a power of two
+    optional<int> alignment = statementVariable->getAlignment();
+    if (alignment && (*alignment <= 0 || (*alignment & (*alignment - 1)) != 0)) {
+        markErrorInvalidAttribute(statementVariable->getLocation(), "@align");
+        return;
+    }
+
     // check initial value expression
     if (statementVariable->getExpression() != nullptr) {
         // cast expression into target
@@ -520,7 +872,25 @@ void Analyzer::checkStatement(shared_ptr<StatementVariable> statementVariable) {
         return;
     }
 
-    if (!scope->setVariableType(statementVariable->getIdentifier(), statementVariable->getValueType(), true)) {
+    // keep track of blobs assigned to proto variables
+    if (statementVariable->getValueType()->isProto()) {
+        string identifier = statementVariable->getIdentifier();
+        // shadowed variables cannot be told apart
+        if (scope->getVariableType(identifier) != nullptr)
+            protoBlobNamesMap[identifier] = nullopt;
+        else if (!protoBlobNamesMap.contains(identifier))
+            protoBlobNamesMap[identifier] = "";
+
+        if (statementVariable->getExpression() != nullptr)
+            trackProtoAssignment(identifier, statementVariable->getExpression());
+    }
+
+    // constants are read-only, just like the arguments passed by reference
+    shared_ptr<ValueType> variableType = statementVariable->getValueType();
+    if (statementVariable->getIsConstant())
+        variableType = ValueType::constant(variableType);
+
+    if (!scope->setVariableType(statementVariable->getIdentifier(), variableType, true)) {
         markErrorAlreadyDefined(statementVariable->getLocation(), statementVariable->getIdentifier());
         return;
     }
@@ -541,7 +911,11 @@ void Analyzer::checkStatement(shared_ptr<StatementVariableDeclaration> statement
     if (resolvedAndCheckedValueType(statementVariableDeclaration->getValueType(), true, statementVariableDeclaration->getLocation()) == nullptr)
         return;
 
-    if (!scope->setVariableType(identifier, statementVariableDeclaration->getValueType(), false))
+    shared_ptr<ValueType> variableType = statementVariableDeclaration->getValueType();
+    if (statementVariableDeclaration->getIsConstant())
+        variableType = ValueType::constant(variableType);
+
+    if (!scope->setVariableType(identifier, variableType, false))
         markErrorAlreadyDefined(statementVariableDeclaration->getLocation(), identifier);
 }
 
@@ -596,9 +970,15 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionBinary> e
     // first try casting right
     // first figure out target type for right expression
     shared_ptr<ValueType> rightTargetType;
-    // bit shift requires right operand to be unsigned integer
-    if (expressionBinary->getOperation() == ExpressionBinaryOperation::BIT_SHL || expressionBinary->getOperation() == ExpressionBinaryOperation::BIT_SHR) {
+    bool isShift = expressionBinary->getOperation() == ExpressionBinaryOperation::BIT_SHL || expressionBinary->getOperation() == ExpressionBinaryOperation::BIT_SHR;
+    // bit shift requires right operand to be unsigned integer (or a vector of shift amounts)
+    if (isShift && originalLeftValueType->isVec() && originalRightValueType->isVec()) {
+        rightTargetType = typeForExpression(expressionBinary->getLeft(), nullptr, nullptr);
+    } else if (isShift) {
         rightTargetType = ValueType::UINT;
+    } else if (originalLeftValueType->isData() && !originalRightValueType->isData()) {
+        // a single value is applied to each of the elements
+        rightTargetType = originalLeftValueType->getSubType();
     } else {
         rightTargetType = typeForExpression(expressionBinary->getLeft(), nullptr, nullptr);
     }
@@ -619,8 +999,14 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionBinary> e
         return nullptr;
 
     // then try casting left expression
-    // firgure target type
-    shared_ptr<ValueType> leftTargetType = typeForExpression(expressionBinary->getRight(), nullptr, nullptr);
+    // firgure target type (shifted vector and data stay as they are)
+    shared_ptr<ValueType> leftTargetType;
+    if ((isShift && originalLeftValueType->isVec()) || originalLeftValueType->isData())
+        leftTargetType = typeForExpression(expressionBinary->getLeft(), nullptr, nullptr);
+    else if (originalRightValueType->isData())
+        leftTargetType = originalRightValueType->getSubType();
+    else
+        leftTargetType = typeForExpression(expressionBinary->getRight(), nullptr, nullptr);
     if (leftTargetType == nullptr) {
         markErrorInvalidType(expressionBinary->getRight()->getLocation(), leftTargetType, nullptr);
         return nullptr;
@@ -665,6 +1051,8 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionCall> exp
     shared_ptr<ValueType> valueType;
 
     int extraArguments = 0;
+    // only operations on values and other @pure functions can be called from a @pure function
+    bool isCallPure = false;
 
     // check for built-in
     if (parentExpression != nullptr) {
@@ -672,12 +1060,69 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionCall> exp
         bool isParentBlob = parentExpression->getValueType()->isBlob();
         bool isParentProto = parentExpression->getValueType()->isProto();
         bool isVal = expressionCall->getName().compare("val") == 0;
+        bool isRotate = expressionCall->getName().compare("rotl") == 0 || expressionCall->getName().compare("rotr") == 0;
+        bool isFma = expressionCall->getName().compare("fma") == 0;
+        bool isMinMax = expressionCall->getName().compare("min") == 0 || expressionCall->getName().compare("max") == 0;
+        bool isPrefetch = expressionCall->getName().compare("prefetch") == 0;
+        bool isStoreNT = expressionCall->getName().compare("storeNT") == 0;
+        bool isAssumeAligned = expressionCall->getName().compare("assumeAligned") == 0;
+        bool isParentAddress = isParentPointer || parentExpression->getValueType()->getKind() == ValueTypeKind::A;
+
+        // numbers and vectors of them (lane by lane)
+        shared_ptr<ValueType> parentType = parentExpression->getValueType();
+        shared_ptr<ValueType> parentElementType = parentType->isVec() ? parentType->getSubType() : parentType;
+        bool isParentNumber = parentElementType->isNumeric() && parentElementType->getKind() != ValueTypeKind::A;
 
         if (isParentPointer && isVal && parentExpression->getValueType()->getSubType()->isFunction()) {
             valueType = parentExpression->getValueType()->getSubType();
+        } else if (isParentNumber && (isRotate || isFma || isMinMax)) {
+            isCallPure = true;
+            // built-in operations take arguments of the same type as the value
+            if (isRotate && parentElementType->isInteger()) {
+                valueType = ValueType::fun({parentType}, parentType);
+            } else if (isFma && parentElementType->isFloat()) {
+                valueType = ValueType::fun({parentType, parentType}, parentType);
+            } else if (isMinMax) {
+                valueType = ValueType::fun({parentType}, parentType);
+            } else {
+                markErrorInvalidBuiltIn(expressionCall->getLocation(), expressionCall->getName(), parentType);
+                return nullptr;
+            }
+        } else if (isParentAddress && (isPrefetch || isStoreNT || isAssumeAligned)) {
+            vector<shared_ptr<Expression>> argumentExpressions = expressionCall->getArgumentExpressions();
+            // hints have to be known at compile time
+            bool isValid = true;
+            for (shared_ptr<Expression> &argumentExpression : argumentExpressions) {
+                if (!isStoreNT && dynamic_pointer_cast<ExpressionLiteral>(argumentExpression) == nullptr)
+                    isValid = false;
+            }
+
+            if (isPrefetch && isValid && argumentExpressions.size() == 2) {
+                // read or write, and locality from 0 (none) to 3 (keep in all the caches)
+                isValid = dynamic_pointer_cast<ExpressionLiteral>(argumentExpressions.at(1))->getUIntValue() <= 3;
+                valueType = ValueType::fun({ValueType::BOOL, ValueType::U32}, ValueType::NONE);
+            } else if (isAssumeAligned && isValid && argumentExpressions.size() == 1) {
+                isCallPure = true;
+                uint64_t alignment = dynamic_pointer_cast<ExpressionLiteral>(argumentExpressions.at(0))->getUIntValue();
+                isValid = alignment > 0 && (alignment & (alignment - 1)) == 0;
+                valueType = ValueType::fun({ValueType::UINT}, parentType);
+            } else if (isStoreNT && isParentPointer) {
+                // only simple values can be stored
+                shared_ptr<ValueType> pointeeType = parentType->getSubType();
+                isValid = pointeeType->isNumeric() || pointeeType->isBool() || pointeeType->isVec();
+                valueType = ValueType::fun({pointeeType}, ValueType::NONE);
+            } else {
+                isValid = false;
+            }
+
+            if (!isValid) {
+                markErrorInvalidBuiltIn(expressionCall->getLocation(), expressionCall->getName(), parentType);
+                return nullptr;
+            }
         } else if (isParentBlob) {
             string functionName = format("{}.{}", *(parentExpression->getValueType()->getBlobName()), expressionCall->getName());
             valueType = scope->getFunctionType(functionName);
+            isCallPure = scope->isFunctionPure(functionName);
             valueType->namedTypeKeys = parentExpression->getValueType()->getNamedTypeKeys();
             valueType->namedTypeValues = parentExpression->getValueType()->getNamedTypeValues();
             extraArguments = 1; // for the implicit "it"
@@ -696,6 +1141,7 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionCall> exp
         }
     } else {
         valueType = scope->getFunctionType(expressionCall->getName());
+        isCallPure = scope->isFunctionPure(expressionCall->getName());
     }
 
     // check if defined
@@ -704,6 +1150,9 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionCall> exp
         return nullptr;
     }
 
+    if (isCheckingPureFunction && !isCallPure)
+        markErrorNotPure(expressionCall->getLocation(), expressionCall->getName());
+
     // check arguments count
     vector<shared_ptr<ValueType>> argumentTypes = *(valueType->getArgumentTypes());
     if (argumentTypes.size() != expressionCall->getArgumentExpressions().size() + extraArguments) {
@@ -787,7 +1236,33 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionCast> exp
     bool isTargetPointer = expressionCast->getValueType()->isPointer();
     bool isTargetProto = expressionCast->getValueType()->isProto();
 
-    if (areNumeric || areBool || areDataNumeric || areDataBool | isAddressToPointer) {
+    // vectors are splat from scalars, cast lane by lane, or loaded from and stored into data
+    bool isScalarToVec = isSourceNumeric && !parentExpression->getValueType()->isAddress() && expressionCast->getValueType()->isVec();
+    bool areVecNumeric = parentExpression->getValueType()->isVec() && expressionCast->getValueType()->isVec() &&
+        parentExpression->getValueType()->getValueArg() == expressionCast->getValueType()->getValueArg();
+    bool isDataToVec = parentExpression->getValueType()->isData() && expressionCast->getValueType()->isVec() &&
+        parentExpression->getValueType()->getSubType()->isEqual(expressionCast->getValueType()->getSubType());
+    bool isVecToData = parentExpression->getValueType()->isVec() && isTargetData &&
+        parentExpression->getValueType()->getSubType()->isEqual(expressionCast->getValueType()->getSubType());
+
+    // sized data has to have enough elements for all the lanes
+    if (isDataToVec && dynamic_pointer_cast<ExpressionLiteral>(parentExpression->getValueType()->getCountExpression()) != nullptr)
+        isDataToVec = parentExpression->getValueType()->getValueArg() >= expressionCast->getValueType()->getValueArg();
+    if (isVecToData && dynamic_pointer_cast<ExpressionLiteral>(expressionCast->getValueType()->getCountExpression()) != nullptr)
+        isVecToData = expressionCast->getValueType()->getValueArg() >= parentExpression->getValueType()->getValueArg();
+
+    if (isScalarToVec || areVecNumeric || isDataToVec) {
+        return resolvedAndCheckedValueType(expressionCast->getValueType(), true, expressionCast->getLocation());
+    } else if (isVecToData) {
+        // data takes all the lanes, unless told otherwise
+        if (expressionCast->getValueType()->getCountExpression() == nullptr) {
+            expressionCast->valueType = ValueType::data(
+                expressionCast->getValueType()->getSubType(),
+                parentExpression->getValueType()->getCountExpression()
+            );
+        }
+        return expressionCast->getValueType();
+    } else if (areNumeric || areBool || areDataNumeric || areDataBool | isAddressToPointer) {
         // if cast does not have a count expression, use one from the parent expression
         if (expressionCast->getValueType()->isData() && expressionCast->getValueType()->getCountExpression() == nullptr) {
             expressionCast->valueType = ValueType::data(
@@ -830,6 +1305,56 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionChained>
             return nullptr;
     }
 
+    // keep track of proto calls and of proto variables whose address is taken
+    vector<shared_ptr<Expression>> chainExpressions = expressionChained->getChainExpressions();
+    for (int i=1; i<chainExpressions.size(); i++) {
+        shared_ptr<Expression> protoExpression = chainExpressions.at(i - 1);
+        if (!protoExpression->getValueType()->isProto())
+            continue;
+
+        // only variables at the start of the chain are tracked
+        string identifier;
+        shared_ptr<ExpressionValue> rootExpressionValue = dynamic_pointer_cast<ExpressionValue>(protoExpression);
+        if (i == 1 && rootExpressionValue != nullptr && rootExpressionValue->getIndexExpression() == nullptr)
+            identifier = rootExpressionValue->getIdentifier();
+
+        if (shared_ptr<ExpressionCall> expressionCall = dynamic_pointer_cast<ExpressionCall>(chainExpressions.at(i))) {
+            protoCalls.push_back(make_tuple(expressionCall, *protoExpression->getValueType()->getProtoName(), identifier));
+        } else if (shared_ptr<ExpressionValue> expressionValue = dynamic_pointer_cast<ExpressionValue>(chainExpressions.at(i))) {
+            if (!identifier.empty() && expressionValue->getIdentifier().compare("adr") == 0)
+                protoBlobNamesMap[identifier] = nullopt;
+        }
+    }
+
+    // arguments passed by reference and constants can't be modified through their address,
+    // constants are in read-only memory so they also can't be modified by member functions, unless those are @pure
+    shared_ptr<ExpressionValue> rootExpressionValue = dynamic_pointer_cast<ExpressionValue>(chainExpressions.front());
+    shared_ptr<ValueType> rootType = rootExpressionValue != nullptr ? scope->getVariableType(rootExpressionValue->getIdentifier()) : nullptr;
+    for (int i=1; rootType != nullptr && rootType->isReference() && i<chainExpressions.size(); i++) {
+        // pointed to memory is not a part of the value
+        shared_ptr<ValueType> parentType = chainExpressions.at(i - 1)->getValueType();
+        if (parentType->isPointer() || parentType->isProto())
+            break;
+
+        bool isAddressTaken = false;
+        if (shared_ptr<ExpressionValue> expressionValue = dynamic_pointer_cast<ExpressionValue>(chainExpressions.at(i)))
+            isAddressTaken = expressionValue->getValueKind() == ExpressionValueKind::BUILT_IN_ADR;
+
+        bool isModifyingCall = false;
+        shared_ptr<ExpressionCall> expressionCall = dynamic_pointer_cast<ExpressionCall>(chainExpressions.at(i));
+        if (expressionCall != nullptr && parentType->isBlob() && rootType->isConstant())
+            isModifyingCall = !scope->isFunctionPure(format("{}.{}", *(parentType->getBlobName()), expressionCall->getName()));
+
+        if (isAddressTaken || isModifyingCall) {
+            markErrorReadOnly(chainExpressions.at(i)->getLocation(), rootExpressionValue->getIdentifier());
+            return nullptr;
+        }
+
+        // result of a call is a new value
+        if (expressionCall != nullptr)
+            break;
+    }
+
     expressionChained->valueType = parentExpression->getValueType();
     return expressionChained->getValueType();
 }
@@ -966,18 +1491,37 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionValue> ex
         bool isParentPointer = parentExpression->getValueType()->isPointer();
         bool isParentBlob = parentExpression->getValueType()->isBlob();
         bool isParentProto = parentExpression->getValueType()->isProto();
+        bool isParentVec = parentExpression->getValueType()->isVec();
 
         bool isCount = expressionValue->getIdentifier().compare("count") == 0;
         bool isVal = expressionValue->getIdentifier().compare("val") == 0;
+        bool isVol = expressionValue->getIdentifier().compare("vol") == 0;
         bool isVadr = expressionValue->getIdentifier().compare("vadr") == 0;
         bool isAdr = expressionValue->getIdentifier().compare("adr") == 0;
         bool isSize = expressionValue->getIdentifier().compare("size") == 0;
+        bool isSum = expressionValue->getIdentifier().compare("sum") == 0;
+        bool isMin = expressionValue->getIdentifier().compare("min") == 0;
+        bool isMax = expressionValue->getIdentifier().compare("max") == 0;
+        bool isAny = expressionValue->getIdentifier().compare("any") == 0;
+        bool isAll = expressionValue->getIdentifier().compare("all") == 0;
+        bool isPopcount = expressionValue->getIdentifier().compare("popcount") == 0;
+        bool isClz = expressionValue->getIdentifier().compare("clz") == 0;
+        bool isCtz = expressionValue->getIdentifier().compare("ctz") == 0;
+        bool isBswap = expressionValue->getIdentifier().compare("bswap") == 0;
+        bool isSqrt = expressionValue->getIdentifier().compare("sqrt") == 0;
+        bool isAbs = expressionValue->getIdentifier().compare("abs") == 0;
+        bool isFloor = expressionValue->getIdentifier().compare("floor") == 0;
+        bool isCeil = expressionValue->getIdentifier().compare("ceil") == 0;
+
+        // numbers and vectors of them (lane by lane)
+        shared_ptr<ValueType> parentElementType = isParentVec ? parentExpression->getValueType()->getSubType() : parentExpression->getValueType();
+        bool isParentNumber = parentElementType->isNumeric() && parentElementType->getKind() != ValueTypeKind::A;
 
         if (isParentData && isCount) {
             expressionValue->valueType = ValueType::UINT;
             expressionValue->valueKind = ExpressionValueKind::BUILT_IN_COUNT;
             return expressionValue->getValueType();
-        } else if (isParentPointer && isVal) {
+        } else if (isParentPointer && (isVal || isVol)) {
             switch (expressionValue->getValueKind()) {
                 case ExpressionValueKind::SIMPLE:
                 case ExpressionValueKind::BUILT_IN_VAL_SIMPLE:
@@ -1012,6 +1556,54 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionValue> ex
             expressionValue->valueType = ValueType::UINT;
             expressionValue->valueKind = ExpressionValueKind::BUILT_IN_SIZE;
             return expressionValue->getValueType();
+        } else if ((isParentData || isParentVec) && (isSum || isMin || isMax || isAny || isAll)) {
+            // all the elements are reduced into a single value
+            shared_ptr<ValueType> elementType = parentExpression->getValueType()->getSubType();
+            bool isCountKnown = isParentVec || (
+                dynamic_pointer_cast<ExpressionLiteral>(parentExpression->getValueType()->getCountExpression()) != nullptr &&
+                parentExpression->getValueType()->getValueArg() > 0
+            );
+            bool isElementNumeric = elementType->isNumeric() && elementType->getKind() != ValueTypeKind::A;
+            // masks are checked with any and all
+            bool isElementLogical = isParentData ? elementType->isBool() : elementType->isInteger();
+
+            if (isCountKnown && (isSum || isMin || isMax) && isElementNumeric) {
+                expressionValue->valueType = elementType;
+            } else if (isCountKnown && (isAny || isAll) && isElementLogical) {
+                expressionValue->valueType = ValueType::BOOL;
+            } else {
+                markErrorInvalidBuiltIn(
+                    expressionValue->getLocation(),
+                    expressionValue->getIdentifier(),
+                    parentExpression->getValueType()
+                );
+                return nullptr;
+            }
+            expressionValue->valueKind = ExpressionValueKind::BUILT_IN_REDUCTION;
+            return expressionValue->getValueType();
+        } else if (isParentNumber && (isPopcount || isClz || isCtz || isBswap || isSqrt || isAbs || isFloor || isCeil)) {
+            bool isValid;
+            if (isPopcount || isClz || isCtz || isBswap)
+                isValid = parentElementType->isInteger();
+            else if (isAbs)
+                isValid = parentElementType->isFloat() || parentElementType->isSignedInteger();
+            else
+                isValid = parentElementType->isFloat();
+            // bytes can only be swapped for types with even number of them
+            if (isBswap && (parentElementType->getKind() == ValueTypeKind::U8 || parentElementType->getKind() == ValueTypeKind::S8))
+                isValid = false;
+
+            if (!isValid) {
+                markErrorInvalidBuiltIn(
+                    expressionValue->getLocation(),
+                    expressionValue->getIdentifier(),
+                    parentExpression->getValueType()
+                );
+                return nullptr;
+            }
+            expressionValue->valueType = parentExpression->getValueType();
+            expressionValue->valueKind = ExpressionValueKind::BUILT_IN_INTRINSIC;
+            return expressionValue->getValueType();
         // check blob member
         } else if (isParentBlob) {
             shared_ptr<ValueType> blobValueType = parentExpression->getValueType();
@@ -1079,6 +1671,10 @@ shared_ptr<ValueType> Analyzer::typeForExpression(shared_ptr<ExpressionValue> ex
         expressionValue->valueKind = ExpressionValueKind::SIMPLE;
     }
 
+    // @pure functions can read only the constants of the module (which are read-only references)
+    if (isCheckingPureFunction && parentExpression == nullptr && type != nullptr && !type->isReference() && !scope->isVariableLocal(expressionValue->getIdentifier()))
+        markErrorNotPure(expressionValue->getLocation(), expressionValue->getIdentifier());
+
     // then check if it's data
     if (type != nullptr && expressionValue->getIndexExpression() != nullptr) {
         expressionValue->indexExpression = checkAndTryCasting(
@@ -1188,6 +1784,45 @@ bool Analyzer::isBinaryOperationValidForTypes(ExpressionBinaryOperation operatio
     if (secondType->isBoxed())
         secondType = secondType->getSubType();
 
+    // whole data is processed element by element, either with other data or with a single value
+    if (firstType->isData() || secondType->isData()) {
+        switch (operation) {
+            case ExpressionBinaryOperation::BIT_SHL:
+            case ExpressionBinaryOperation::BIT_SHR: {
+                if (!firstType->isData() || !firstType->getSubType()->isInteger())
+                    return false;
+                break;
+            }
+            case ExpressionBinaryOperation::BIT_OR:
+            case ExpressionBinaryOperation::BIT_XOR:
+            case ExpressionBinaryOperation::BIT_AND:
+
+            case ExpressionBinaryOperation::ADD:
+            case ExpressionBinaryOperation::SUB:
+            case ExpressionBinaryOperation::MUL:
+            case ExpressionBinaryOperation::DIV:
+            case ExpressionBinaryOperation::MOD:
+                break;
+            default:
+                return false;
+        }
+
+        // elements count has to be known
+        shared_ptr<ValueType> dataType = firstType->isData() ? firstType : secondType;
+        if (dynamic_pointer_cast<ExpressionLiteral>(dataType->getCountExpression()) == nullptr || dataType->getValueArg() <= 0)
+            return false;
+        if (!dataType->getSubType()->isNumeric() || dataType->getSubType()->getKind() == ValueTypeKind::A)
+            return false;
+        if (firstType->isData() && secondType->isData() && !firstType->isEqual(secondType))
+            return false;
+
+        return isBinaryOperationValidForTypes(
+            operation,
+            firstType->isData() ? firstType->getSubType() : firstType,
+            secondType->isData() ? secondType->getSubType() : secondType
+        );
+    }
+
     switch (firstType->getKind()) {
         // Valid operations for boolean types
         case ValueTypeKind::BOOL: {
@@ -1265,6 +1900,42 @@ bool Analyzer::isBinaryOperationValidForTypes(ExpressionBinaryOperation operatio
             }
             break;
         }
+        // Valid operations for vectors, done on each of the lanes
+        case ValueTypeKind::VEC: {
+            switch (operation) {
+                // shift amount is either given for each lane or is the same for all of them
+                case ExpressionBinaryOperation::BIT_SHL:
+                case ExpressionBinaryOperation::BIT_SHR: {
+                    if (!firstType->getSubType()->isInteger())
+                        return false;
+                    return firstType->isEqual(secondType) || secondType->isUnsignedInteger();
+                }
+
+                case ExpressionBinaryOperation::BIT_OR:
+                case ExpressionBinaryOperation::BIT_XOR:
+                case ExpressionBinaryOperation::BIT_AND: {
+                    return firstType->getSubType()->isInteger() && firstType->isEqual(secondType);
+                }
+
+                case ExpressionBinaryOperation::EQUAL:
+                case ExpressionBinaryOperation::NOT_EQUAL:
+                case ExpressionBinaryOperation::LESS:
+                case ExpressionBinaryOperation::LESS_EQUAL:
+                case ExpressionBinaryOperation::GREATER:
+                case ExpressionBinaryOperation::GREATER_EQUAL:
+
+                case ExpressionBinaryOperation::ADD:
+                case ExpressionBinaryOperation::SUB:
+                case ExpressionBinaryOperation::MUL:
+                case ExpressionBinaryOperation::DIV:
+                case ExpressionBinaryOperation::MOD: {
+                    return firstType->isEqual(secondType);
+                }
+                default:
+                    break;
+            }
+            break;
+        }
         default:
             break;
     }
@@ -1307,12 +1978,40 @@ shared_ptr<ValueType> Analyzer::typeForUnaryOperation(ExpressionUnaryOperation o
         case ExpressionBinaryOperation::LESS_EQUAL:
         case ExpressionBinaryOperation::GREATER:
         case ExpressionBinaryOperation::GREATER_EQUAL:
-        case ExpressionBinaryOperation::BIT_TEST:
-            return ValueType::BOOL;
+        case ExpressionBinaryOperation::BIT_TEST: {
+            if (!firstType->isVec())
+                return ValueType::BOOL;
+
+            // vectors are compared into a mask, with all lane bits set where true
+            shared_ptr<ValueType> maskLaneType;
+            switch (firstType->getSubType()->getKind()) {
+                case ValueTypeKind::U8:
+                case ValueTypeKind::S8:
+                    maskLaneType = ValueType::S8;
+                    break;
+                case ValueTypeKind::U16:
+                case ValueTypeKind::S16:
+                    maskLaneType = ValueType::S16;
+                    break;
+                case ValueTypeKind::U32:
+                case ValueTypeKind::S32:
+                case ValueTypeKind::F32:
+                    maskLaneType = ValueType::S32;
+                    break;
+                default:
+                    maskLaneType = ValueType::S64;
+                    break;
+            }
+            return ValueType::vec(maskLaneType, firstType->getCountExpression());
+        }
         default:
             break;
     }
 
+    // a single value applied to data gives data
+    if (!firstType->isData() && secondType->isData())
+        return secondType;
+
     // not change
     return firstType;
 }
@@ -1332,9 +2031,12 @@ shared_ptr<Expression> Analyzer::checkAndTryCasting(shared_ptr<Expression> sourc
         return sourceExpression;
 
     // single literal just needs to set the type
-    if (sourceExpression->getKind() == ExpressionKind::LITERAL && !targetType->isBoxed()) {
+    if (sourceExpression->getKind() == ExpressionKind::LITERAL && !targetType->isBoxed() && !targetType->isVec()) {
         sourceExpression->valueType = targetType;
         return sourceExpression;
+    // literal splat into vector takes the type of the lanes first
+    } else if (sourceExpression->getKind() == ExpressionKind::LITERAL && targetType->isVec()) {
+        sourceExpression->valueType = targetType->getSubType();
     // composite to blob
     } else if (sourceExpression->getKind() == ExpressionKind::COMPOSITE_LITERAL && targetType->isBlob()) {
         sourceExpression->valueType = targetType;
@@ -1345,6 +2047,13 @@ shared_ptr<Expression> Analyzer::checkAndTryCasting(shared_ptr<Expression> sourc
             expressionCompositeLiteral->expressions[i] = checkAndTryCasting(expressionCompositeLiteral->getExpressions().at(i), memberType, returnType);
         }
         return sourceExpression;
+    // composite to vec
+    } else if (sourceExpression->getKind() == ExpressionKind::COMPOSITE_LITERAL && targetType->isVec()) {
+        sourceExpression->valueType = targetType;
+        shared_ptr<ExpressionCompositeLiteral> expressionCompositeLiteral = dynamic_pointer_cast<ExpressionCompositeLiteral>(sourceExpression);
+        for (int i=0; i<expressionCompositeLiteral->getExpressions().size(); i++)
+            expressionCompositeLiteral->expressions[i] = checkAndTryCasting(expressionCompositeLiteral->getExpressions().at(i), targetType->getSubType(), returnType);
+        return sourceExpression;
     // composite to proto
     } else if (sourceExpression->getKind() == ExpressionKind::COMPOSITE_LITERAL && targetType->isProto()) {
         sourceExpression->valueType = targetType;
@@ -1459,6 +2168,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::A:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1487,6 +2199,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::F64:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1510,6 +2225,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::F64:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1548,6 +2266,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::A:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1582,6 +2303,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::A:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1614,6 +2338,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::A:
                     return true;
                 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1644,6 +2371,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::A:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1674,6 +2404,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::F64:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1701,6 +2434,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::F64:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1727,6 +2463,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::F64:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1752,6 +2491,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::F64:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1776,6 +2518,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::F64:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1797,6 +2542,9 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                 case ValueTypeKind::F64:
                     return true;
 
+                case ValueTypeKind::VEC:
+                    return canImplicitCast(sourceType, targetType->getSubType());
+
                 case ValueTypeKind::BOXED:
                     return canImplicitCast(sourceType, targetType->getSubType());
 
@@ -1898,6 +2646,18 @@ bool Analyzer::canImplicitCast(shared_ptr<ValueType> sourceType, shared_ptr<Valu
                     return true;
                 }
 
+                // to vec
+                case ValueTypeKind::VEC: {
+                    vector<shared_ptr<ValueType>> sourceElementTypes = *(sourceType->getCompositeElementTypes());
+                    if (sourceElementTypes.size() != targetType->getValueArg())
+                        return false;
+                    for (shared_ptr<ValueType> sourceElementType : sourceElementTypes) {
+                        if (!canImplicitCast(sourceElementType, targetType->getSubType()))
+                            return false;
+                    }
+                    return true;
+                }
+
                 // to blob
                 case ValueTypeKind::BLOB: {
                     // get target non-function types
@@ -1997,16 +2757,34 @@ shared_ptr<ValueType> Analyzer::resolvedAndCheckedValueType(shared_ptr<ValueType
                 return false;
             } else
             */
-            if (!valueType->namedTypeKeys)
-                valueType->namedTypeKeys = scope->getBlobNamedTypeKeys(*valueType->getBlobName());
+            // type may be shared between the workers, so it's only written if it hasn't been resolved yet
+            if (!valueType->namedTypeKeys) {
+                optional<vector<string>> namedTypeKeys = scope->getBlobNamedTypeKeys(*valueType->getBlobName());
+                if (namedTypeKeys)
+                    valueType->namedTypeKeys = namedTypeKeys;
+            }
+
+            // generic blobs are built separately for each set of type arguments
+            if (blobSpecializations != nullptr && valueType->getNamedTypeValues()) {
+                string blobName = *valueType->getBlobName();
+                if (blobName.find('.', 0) == string::npos)
+                    blobName = format("{}.{}", module->getName(), blobName);
+                blobSpecializations->addTypeArguments(blobName, *valueType->getNamedTypeValues());
+            }
             return valueType;
         }
         case ValueTypeKind::BOXED: {
             return ValueType::boxed(resolvedAndCheckedValueType(valueType->getSubType(), false, location));
         }
         case ValueTypeKind::DATA: {
+            // so the element blob gets specialized
+            if (blobSpecializations != nullptr && valueType->getSubType() != nullptr && valueType->getSubType()->isBlob())
+                resolvedAndCheckedValueType(valueType->getSubType(), false, location);
+
             if (valueType->getCountExpression() != nullptr) {
-                valueType->getCountExpression()->valueType = typeForExpression(valueType->getCountExpression(), nullptr, nullptr);
+                // count may belong to a shared declaration, so it's only resolved once
+                if (valueType->getCountExpression()->getValueType() == nullptr)
+                    valueType->getCountExpression()->valueType = typeForExpression(valueType->getCountExpression(), nullptr, nullptr);
                 return valueType;
             } else if (isCountExperssionRequired) {
                 markErrorInvalidType(location, valueType, nullptr);
@@ -2014,6 +2792,19 @@ shared_ptr<ValueType> Analyzer::resolvedAndCheckedValueType(shared_ptr<ValueType
             }
             return valueType;
         }
+        case ValueTypeKind::VEC: {
+            // lanes are sized numbers and their count has to be known upfront
+            shared_ptr<ValueType> subType = valueType->getSubType();
+            bool isSubTypeValid = subType != nullptr && subType->isNumeric() && !subType->isAddress();
+            shared_ptr<ExpressionLiteral> countExpression = dynamic_pointer_cast<ExpressionLiteral>(valueType->getCountExpression());
+            if (!isSubTypeValid || countExpression == nullptr || countExpression->getUIntValue() <= 0) {
+                markErrorInvalidType(location, valueType, nullptr);
+                return nullptr;
+            }
+            if (countExpression->getValueType() == nullptr)
+                countExpression->valueType = typeForExpression(countExpression, nullptr, nullptr);
+            return valueType;
+        }
         case ValueTypeKind::FUN: {
             vector<shared_ptr<ValueType>> argValueTypes = *valueType->getArgumentTypes();
             for (shared_ptr<ValueType> argValueType : argValueTypes) {
@@ -2057,6 +2848,42 @@ shared_ptr<ValueType> Analyzer::resolvedAndCheckedValueType(shared_ptr<ValueType
     }
 }
 
+void Analyzer::trackProtoAssignment(string identifier, shared_ptr<Expression> valueExpression) {
+    // only local variables are tracked
+    auto it = protoBlobNamesMap.find(identifier);
+    if (it == protoBlobNamesMap.end() || !it->second)
+        return;
+
+    // blob is known only for composite literals
+    optional<string> blobName;
+    shared_ptr<ExpressionCompositeLiteral> expressionCompositeLiteral = dynamic_pointer_cast<ExpressionCompositeLiteral>(valueExpression);
+    if (expressionCompositeLiteral != nullptr && !expressionCompositeLiteral->getExpressions().empty()) {
+        shared_ptr<ValueType> pointerType = expressionCompositeLiteral->getExpressions().front()->getValueType();
+        if (pointerType != nullptr && pointerType->isPointer() && pointerType->getSubType()->isBlob())
+            blobName = pointerType->getSubType()->getBlobName();
+    }
+
+    // and it has to be the same one for all of the assignments
+    if (!blobName || (!it->second->empty() && it->second->compare(*blobName) != 0))
+        it->second = nullopt;
+    else
+        it->second = blobName;
+}
+
+void Analyzer::devirtualizeProtoCalls() {
+    for (auto &[expressionCall, protoName, identifier] : protoCalls) {
+        auto singleBlobNameIt = singleProtoBlobNamesMap.find(protoName);
+        auto blobNameIt = protoBlobNamesMap.find(identifier);
+
+        // proto is implemented by only one blob
+        if (singleBlobNameIt != singleProtoBlobNamesMap.end())
+            expressionCall->devirtualizedBlobName = singleBlobNameIt->second;
+        // or the variable is always assigned the same one
+        else if (!identifier.empty() && blobNameIt != protoBlobNamesMap.end() && blobNameIt->second && !blobNameIt->second->empty())
+            expressionCall->devirtualizedBlobName = *blobNameIt->second;
+    }
+}
+
 void Analyzer::markErrorAlreadyDefined(shared_ptr<Location> location, string identifier) {
     string message = format("\"{}\" is already defined", identifier);
     errors.push_back(Error::error(location, message));
@@ -2116,6 +2943,16 @@ void Analyzer::markErrorNotImplemented(shared_ptr<Location> location, string pro
     errors.push_back(Error::error(location, message));
 }
 
+void Analyzer::markErrorNotPure(shared_ptr<Location> location, string name) {
+    string message = format("\"{}\" cannot be used in a @pure function", name);
+    errors.push_back(Error::error(location, message));
+}
+
+void Analyzer::markErrorReadOnly(shared_ptr<Location> location, string identifier) {
+    string message = format("\"{}\" is read-only and cannot be modified", identifier);
+    errors.push_back(Error::error(location, message));
+}
+
 void Analyzer::markErrorUnexpectedExpression(shared_ptr<Location> location) {
     string message = format("Unexpected expression");
     errors.push_back(Error::error(location, message));
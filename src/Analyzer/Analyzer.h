@@ -4,10 +4,15 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <set>
+#include <optional>
+#include <tuple>
 #include <format>
 
 class AnalyzerScope;
+class BlobSpecializations;
 class Module;
+class ModuleReachability;
 class Error;
 class Location;
 class ValueType;
@@ -57,7 +62,26 @@ private:
     shared_ptr<AnalyzerScope> scope;
     shared_ptr<Module> module;
     map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap;
+    shared_ptr<map<string, shared_ptr<AnalyzerScope>>> importedScopesMap;
+    shared_ptr<ModuleReachability> reachability;
+    shared_ptr<BlobSpecializations> blobSpecializations;
+    int jobsCount;
     string importModulePrefix;
+    // exported headers being checked, for modules which import each other
+    set<string> checkedImportNames;
+
+    // for devirtualizing proto calls
+    map<string, string> singleProtoBlobNamesMap;
+    map<string, optional<string>> protoBlobNamesMap;
+    vector<tuple<shared_ptr<ExpressionCall>, string, string>> protoCalls;
+
+    // body of a function marked with @pure is being checked
+    bool isCheckingPureFunction = false;
+
+    bool isReachable(shared_ptr<StatementFunction> statementFunction);
+    void checkFunctionBodies(vector<shared_ptr<StatementFunction>> statementFunctions);
+    void resolveSharedValueTypes(vector<shared_ptr<Statement>> statements);
+    void resolveSharedValueType(shared_ptr<ValueType> valueType);
 
     void checkStatement(shared_ptr<Statement> statement, shared_ptr<ValueType> returnType, bool isImported = false);
     void checkStatement(shared_ptr<StatementAssignment> statementAssignment);
@@ -66,6 +90,8 @@ private:
     void checkStatement(shared_ptr<StatementBlock> statementBlock, shared_ptr<ValueType> returnType);
     void checkStatement(shared_ptr<StatementExpression> statementExpression, shared_ptr<ValueType> returnType);
     void checkStatement(shared_ptr<StatementFunction> statementFunction);
+    bool checkFunctionSignature(shared_ptr<StatementFunction> statementFunction);
+    void checkFunctionBody(shared_ptr<StatementFunction> statementFunction);
     void checkStatement(shared_ptr<StatementFunctionDeclaration> statementFunctionDeclaration);
     void checkStatement(shared_ptr<StatementMetaExternFunction> statementMetaExternFunction);
     void checkStatement(shared_ptr<StatementMetaExternVariable> statementMetaExternVariable);
@@ -105,6 +131,9 @@ private:
 
     shared_ptr<ValueType> resolvedAndCheckedValueType(shared_ptr<ValueType> valueType, bool isCountExperssionRequired, shared_ptr<Location> location);
 
+    void trackProtoAssignment(string identifier, shared_ptr<Expression> valueExpression);
+    void devirtualizeProtoCalls();
+
     void markErrorAlreadyDefined(shared_ptr<Location> location, string identifier);
     void markErrorInvalidAttribute(shared_ptr<Location> location, string name);
     void markErrorInvalidArgumentsCount(shared_ptr<Location> location, int actulCount, int expectedCount);
@@ -116,10 +145,19 @@ private:
     void markErrorInvalidType(shared_ptr<Location> location, shared_ptr<ValueType> actualType, shared_ptr<ValueType> expectedType);
     void markErrorNotDefined(shared_ptr<Location> location, string name);
     void markErrorNotImplemented(shared_ptr<Location> location, string protoName, string memberName);
+    void markErrorNotPure(shared_ptr<Location> location, string name);
+    void markErrorReadOnly(shared_ptr<Location> location, string identifier);
     void markErrorUnexpectedExpression(shared_ptr<Location> location);
 
 public:
-    Analyzer(shared_ptr<Module> module, map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap);
+    Analyzer(
+        shared_ptr<Module> module,
+        map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap,
+        shared_ptr<map<string, shared_ptr<AnalyzerScope>>> importedScopesMap,
+        shared_ptr<ModuleReachability> reachability,
+        shared_ptr<BlobSpecializations> blobSpecializations,
+        int jobsCount
+    );
     void checkModule();
 };
 
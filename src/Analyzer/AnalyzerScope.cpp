@@ -14,20 +14,39 @@ void AnalyzerScope::popLevel() {
     scopeLevels.pop();
 }
 
+void AnalyzerScope::freeze() {
+    isFrozen = true;
+}
+
+void AnalyzerScope::attachImportedScope(shared_ptr<AnalyzerScope> importedScope) {
+    importedScopes.push_back(importedScope);
+}
+
 optional<vector<pair<string, shared_ptr<ValueType>>>> AnalyzerScope::getProtoMembers(string name) {
-    stack<ScopeLevel> scopeLevels = this->scopeLevels;
+    return memoizedQuery<optional<vector<pair<string, shared_ptr<ValueType>>>>>(protoMembersQueries, name, [&]() -> optional<vector<pair<string, shared_ptr<ValueType>>>> {
+        stack<ScopeLevel> scopeLevels = this->scopeLevels;
+
+        while (!scopeLevels.empty()) {
+            auto it = scopeLevels.top().protoMembersMap.find(name);
+            if (it != scopeLevels.top().protoMembersMap.end())
+                return scopeLevels.top().protoMembersMap[name];
+            scopeLevels.pop();
+        }
 
-    while (!scopeLevels.empty()) {
-        auto it = scopeLevels.top().protoMembersMap.find(name);
-        if (it != scopeLevels.top().protoMembersMap.end())
-            return scopeLevels.top().protoMembersMap[name];
-        scopeLevels.pop();
-    }
+        for (shared_ptr<AnalyzerScope> &importedScope : importedScopes) {
+            if (auto members = importedScope->getProtoMembers(name))
+                return members;
+        }
 
-    return {};
+        return {};
+    });
 }
 
 bool AnalyzerScope::setProtoMembers(string name, optional<vector<pair<string, shared_ptr<ValueType>>>> members) {
+    // shared scopes are read only
+    if (isFrozen)
+        return false;
+
     bool isDefinition = members.has_value();
     bool isDefined = false;
     if (scopeLevels.top().protoMembersMap.find(name) != scopeLevels.top().protoMembersMap.end())
@@ -47,24 +66,38 @@ optional<vector<pair<string, shared_ptr<ValueType>>>> AnalyzerScope::getBlobMemb
     optional<string> blobName = blobValueType->getBlobName();
     if (!blobName)
         return {};
-    stack<ScopeLevel> scopeLevels = this->scopeLevels;
 
-    while (!scopeLevels.empty()) {
-        auto it = scopeLevels.top().blobMembersMap.find(*blobName);
-        // check if found members
-        if (it != scopeLevels.top().blobMembersMap.end()) {
-            vector<pair<string, shared_ptr<ValueType>>> blobMembers = *scopeLevels.top().blobMembersMap[*blobName];
-            // update named value types
-            for (pair<string, shared_ptr<ValueType>> &blobMember : blobMembers) {
-                blobMember.second->namedTypeKeys = blobValueType->getNamedTypeKeys();
-                blobMember.second->namedTypeValues = blobValueType->getNamedTypeValues();
-            }
-            return blobMembers;
-        }
-        scopeLevels.pop();
+    optional<vector<pair<string, shared_ptr<ValueType>>>> blobMembers = getBlobMembers(*blobName);
+    if (!blobMembers)
+        return {};
+
+    // update named value types, on a copy since the members can be shared between the workers
+    for (pair<string, shared_ptr<ValueType>> &blobMember : *blobMembers) {
+        blobMember.second = make_shared<ValueType>(*blobMember.second);
+        blobMember.second->namedTypeKeys = blobValueType->getNamedTypeKeys();
+        blobMember.second->namedTypeValues = blobValueType->getNamedTypeValues();
     }
+    return blobMembers;
+}
+
+optional<vector<pair<string, shared_ptr<ValueType>>>> AnalyzerScope::getBlobMembers(string blobName) {
+    return memoizedQuery<optional<vector<pair<string, shared_ptr<ValueType>>>>>(blobMembersQueries, blobName, [&]() -> optional<vector<pair<string, shared_ptr<ValueType>>>> {
+        stack<ScopeLevel> scopeLevels = this->scopeLevels;
+
+        while (!scopeLevels.empty()) {
+            auto it = scopeLevels.top().blobMembersMap.find(blobName);
+            if (it != scopeLevels.top().blobMembersMap.end())
+                return it->second;
+            scopeLevels.pop();
+        }
+
+        for (shared_ptr<AnalyzerScope> &importedScope : importedScopes) {
+            if (auto members = importedScope->getBlobMembers(blobName))
+                return members;
+        }
 
-    return {};
+        return {};
+    });
 }
 
 optional<vector<shared_ptr<ValueType>>> AnalyzerScope::getNonFunctionBlobMemberTypes(shared_ptr<ValueType> blobValueType) {
@@ -82,19 +115,30 @@ optional<vector<shared_ptr<ValueType>>> AnalyzerScope::getNonFunctionBlobMemberT
 }
 
 bool AnalyzerScope::isBlobDeclared(string name) {
-    stack<ScopeLevel> scopeLevels = this->scopeLevels;
+    return memoizedQuery<bool>(isBlobDeclaredQueries, name, [&]() -> bool {
+        stack<ScopeLevel> scopeLevels = this->scopeLevels;
 
-    while (!scopeLevels.empty()) {
-        auto it = scopeLevels.top().blobMembersMap.find(name);
-        if (it != scopeLevels.top().blobMembersMap.end())
-            return true;
-        scopeLevels.pop();
-    }
+        while (!scopeLevels.empty()) {
+            auto it = scopeLevels.top().blobMembersMap.find(name);
+            if (it != scopeLevels.top().blobMembersMap.end())
+                return true;
+            scopeLevels.pop();
+        }
 
-    return false;
+        for (shared_ptr<AnalyzerScope> &importedScope : importedScopes) {
+            if (importedScope->isBlobDeclared(name))
+                return true;
+        }
+
+        return false;
+    });
 }
 
 bool AnalyzerScope::setBlobMembers(string name, optional<vector<pair<string, shared_ptr<ValueType>>>> members) {
+    // shared scopes are read only
+    if (isFrozen)
+        return false;
+
     bool isDefinition = members.has_value();
     bool isDefined = false;
     if (scopeLevels.top().blobMembersMap.find(name) != scopeLevels.top().blobMembersMap.end())
@@ -125,6 +169,10 @@ bool AnalyzerScope::isNamedTypeDeclared(string namedType) {
 }
 
 bool AnalyzerScope::setNamedTypes(vector<string> namedTypes) {
+    // shared scopes are read only
+    if (isFrozen)
+        return false;
+
     for (string &namedType : namedTypes) {
         // first check if each of the named types is not yet declared
         for (string &declaredNamedType : scopeLevels.top().namedTypes) {
@@ -137,19 +185,30 @@ bool AnalyzerScope::setNamedTypes(vector<string> namedTypes) {
 }
 
 optional<vector<string>> AnalyzerScope::getBlobNamedTypeKeys(string blobName) {
-    stack<ScopeLevel> scopeLevels = this->scopeLevels;
+    return memoizedQuery<optional<vector<string>>>(blobNamedTypeKeysQueries, blobName, [&]() -> optional<vector<string>> {
+        stack<ScopeLevel> scopeLevels = this->scopeLevels;
+
+        while (!scopeLevels.empty()) {
+            auto it = scopeLevels.top().blobNamedTypeKeysMap.find(blobName);
+            if (it != scopeLevels.top().blobNamedTypeKeysMap.end())
+                return scopeLevels.top().blobNamedTypeKeysMap[blobName];
+            scopeLevels.pop();
+        }
 
-    while (!scopeLevels.empty()) {
-        auto it = scopeLevels.top().blobNamedTypeKeysMap.find(blobName);
-        if (it != scopeLevels.top().blobNamedTypeKeysMap.end())
-            return scopeLevels.top().blobNamedTypeKeysMap[blobName];
-        scopeLevels.pop();
-    }
+        for (shared_ptr<AnalyzerScope> &importedScope : importedScopes) {
+            if (auto namedTypeKeys = importedScope->getBlobNamedTypeKeys(blobName))
+                return namedTypeKeys;
+        }
 
-    return {};
+        return {};
+    });
 }
 
 bool AnalyzerScope::setBlobNamedTypeKeys(string blobName, vector<string> namedTypeKeys) {
+    // shared scopes are read only
+    if (isFrozen)
+        return false;
+
     // check if named types are already defined
     if (scopeLevels.top().blobNamedTypeKeysMap.find(blobName) != scopeLevels.top().blobNamedTypeKeysMap.end())
         return false;
@@ -160,38 +219,60 @@ bool AnalyzerScope::setBlobNamedTypeKeys(string blobName, vector<string> namedTy
 }
 
 optional<vector<string>> AnalyzerScope::getBlobProtoNames(string name) {
-    stack<ScopeLevel> scopeLevels = this->scopeLevels;
+    return memoizedQuery<optional<vector<string>>>(blobProtoNamesQueries, name, [&]() -> optional<vector<string>> {
+        stack<ScopeLevel> scopeLevels = this->scopeLevels;
+
+        while (!scopeLevels.empty()) {
+            auto it = scopeLevels.top().blobProtosMap.find(name);
+            if (it != scopeLevels.top().blobProtosMap.end())
+                return scopeLevels.top().blobProtosMap[name];
+            scopeLevels.pop();
+        }
 
-    while (!scopeLevels.empty()) {
-        auto it = scopeLevels.top().blobProtosMap.find(name);
-        if (it != scopeLevels.top().blobProtosMap.end())
-            return scopeLevels.top().blobProtosMap[name];
-        scopeLevels.pop();
-    }
+        for (shared_ptr<AnalyzerScope> &importedScope : importedScopes) {
+            if (auto protoNames = importedScope->getBlobProtoNames(name))
+                return protoNames;
+        }
 
-    return {};
+        return {};
+    });
 }
 
 bool AnalyzerScope::setBlobProtoNames(string name, vector<string> protoNames) {
+    // shared scopes are read only
+    if (isFrozen)
+        return false;
+
     scopeLevels.top().blobProtosMap[name] = protoNames;
 
     return true;
 }
 
 shared_ptr<ValueType> AnalyzerScope::getVariableType(string identifier) {
-    stack<ScopeLevel> scopeLevels = this->scopeLevels;
+    return memoizedQuery<shared_ptr<ValueType>>(variableTypeQueries, identifier, [&]() -> shared_ptr<ValueType> {
+        stack<ScopeLevel> scopeLevels = this->scopeLevels;
+
+        while (!scopeLevels.empty()) {
+            shared_ptr<ValueType> type = scopeLevels.top().variableTypes[identifier];
+            if (type != nullptr)
+                return type;
+            scopeLevels.pop();
+        }
 
-    while (!scopeLevels.empty()) {
-        shared_ptr<ValueType> type = scopeLevels.top().variableTypes[identifier];
-        if (type != nullptr)
-            return type;
-        scopeLevels.pop();
-    }
+        for (shared_ptr<AnalyzerScope> &importedScope : importedScopes) {
+            if (shared_ptr<ValueType> type = importedScope->getVariableType(identifier))
+                return type;
+        }
 
-    return nullptr;
+        return nullptr;
+    });
 }
 
 bool AnalyzerScope::setVariableType(string identifier, shared_ptr<ValueType> type, bool isDefinition) {
+    // shared scopes are read only
+    if (isFrozen)
+        return false;
+
     shared_ptr<ValueType> existingType = scopeLevels.top().variableTypes[identifier];
     if (existingType != nullptr) {
         // defining already defined variable
@@ -215,20 +296,45 @@ bool AnalyzerScope::setVariableType(string identifier, shared_ptr<ValueType> typ
     return true;
 }
 
-shared_ptr<ValueType> AnalyzerScope::getFunctionType(string name) {
+bool AnalyzerScope::isVariableLocal(string identifier) {
+    // imported scopes only contain the module variables
     stack<ScopeLevel> scopeLevels = this->scopeLevels;
 
     while (!scopeLevels.empty()) {
-        shared_ptr<ValueType> type = scopeLevels.top().functionTypeMap[name];
-        if (type != nullptr)
-            return type;
+        auto it = scopeLevels.top().variableTypes.find(identifier);
+        if (it != scopeLevels.top().variableTypes.end() && it->second != nullptr)
+            return true;
         scopeLevels.pop();
     }
 
-    return nullptr;
+    return false;
+}
+
+shared_ptr<ValueType> AnalyzerScope::getFunctionType(string name) {
+    return memoizedQuery<shared_ptr<ValueType>>(functionTypeQueries, name, [&]() -> shared_ptr<ValueType> {
+        stack<ScopeLevel> scopeLevels = this->scopeLevels;
+
+        while (!scopeLevels.empty()) {
+            shared_ptr<ValueType> type = scopeLevels.top().functionTypeMap[name];
+            if (type != nullptr)
+                return type;
+            scopeLevels.pop();
+        }
+
+        for (shared_ptr<AnalyzerScope> &importedScope : importedScopes) {
+            if (shared_ptr<ValueType> type = importedScope->getFunctionType(name))
+                return type;
+        }
+
+        return nullptr;
+    });
 }
 
 bool AnalyzerScope::setFunctionType(string name, shared_ptr<ValueType> type, bool isDefinition) {
+    // shared scopes are read only
+    if (isFrozen)
+        return false;
+
     shared_ptr<ValueType> existingType = scopeLevels.top().functionTypeMap[name];
     if (existingType != nullptr) {
         // defining already defined function
@@ -245,3 +351,32 @@ bool AnalyzerScope::setFunctionType(string name, shared_ptr<ValueType> type, boo
 
     return true;
 }
+
+
+bool AnalyzerScope::isFunctionPure(string name) {
+    return memoizedQuery<bool>(isFunctionPureQueries, name, [&]() -> bool {
+        stack<ScopeLevel> scopeLevels = this->scopeLevels;
+
+        while (!scopeLevels.empty()) {
+            if (scopeLevels.top().pureFunctionNames.contains(name))
+                return true;
+            scopeLevels.pop();
+        }
+
+        for (shared_ptr<AnalyzerScope> &importedScope : importedScopes) {
+            if (importedScope->isFunctionPure(name))
+                return true;
+        }
+
+        return false;
+    });
+}
+
+bool AnalyzerScope::setFunctionPure(string name) {
+    // shared scopes are read only
+    if (isFrozen)
+        return false;
+
+    scopeLevels.top().pureFunctionNames.insert(name);
+    return true;
+}
\ No newline at end of file
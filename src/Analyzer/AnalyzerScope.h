@@ -7,6 +7,9 @@
 #include <memory>
 #include <vector>
 #include <optional>
+#include <set>
+#include <functional>
+#include <mutex>
 
 class ValueType;
 
@@ -27,9 +30,45 @@ private:
 
         map<string, shared_ptr<ValueType>> functionTypeMap;
         map<string, bool> isFunctionDefinedMap;
+        set<string> pureFunctionNames;
     } ScopeLevel;
 
     stack<ScopeLevel> scopeLevels;
+    // Frozen scopes of the imported modules, looked up after the local levels
+    vector<shared_ptr<AnalyzerScope>> importedScopes;
+    bool isFrozen = false;
+
+    // Memoized query results, a frozen scope only depends on its own header and its imports so they never go stale
+    map<string, optional<vector<pair<string, shared_ptr<ValueType>>>>> protoMembersQueries;
+    map<string, optional<vector<pair<string, shared_ptr<ValueType>>>>> blobMembersQueries;
+    map<string, bool> isBlobDeclaredQueries;
+    map<string, optional<vector<string>>> blobNamedTypeKeysQueries;
+    map<string, optional<vector<string>>> blobProtoNamesQueries;
+    map<string, shared_ptr<ValueType>> variableTypeQueries;
+    map<string, shared_ptr<ValueType>> functionTypeQueries;
+    map<string, bool> isFunctionPureQueries;
+    mutex queryMutex;
+
+    template <typename T>
+    T memoizedQuery(map<string, T> &queryResults, string key, function<T()> query) {
+        if (!isFrozen)
+            return query();
+
+        // frozen scopes can be queried from multiple threads
+        {
+            lock_guard<mutex> lock(queryMutex);
+            auto it = queryResults.find(key);
+            if (it != queryResults.end())
+                return it->second;
+        }
+
+        T result = query();
+        lock_guard<mutex> lock(queryMutex);
+        queryResults[key] = result;
+        return result;
+    }
+
+    optional<vector<pair<string, shared_ptr<ValueType>>>> getBlobMembers(string blobName);
 
 public:
     AnalyzerScope();
@@ -37,6 +76,10 @@ public:
     void pushLevel();
     void popLevel();
 
+    void freeze();
+    void attachImportedScope(shared_ptr<AnalyzerScope> importedScope);
+
+
     optional<vector<pair<string, shared_ptr<ValueType>>>> getProtoMembers(string name);
     bool setProtoMembers(string name, optional<vector<pair<string, shared_ptr<ValueType>>>> members);
     
@@ -56,9 +99,12 @@ public:
 
     shared_ptr<ValueType> getVariableType(string identifier);
     bool setVariableType(string identifier, shared_ptr<ValueType> type, bool isDefinition);
+    bool isVariableLocal(string identifier);
 
     shared_ptr<ValueType> getFunctionType(string name);
     bool setFunctionType(string name, shared_ptr<ValueType> type, bool isDefinition);
+    bool isFunctionPure(string name);
+    bool setFunctionPure(string name);
 };
 
 #endif
\ No newline at end of file
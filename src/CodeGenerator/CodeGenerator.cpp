@@ -2,6 +2,41 @@
 
 using namespace std;
 
+// Prints what the loop passes did with each loop, including the `rep` optimization hints
+// which were requested but couldn't be applied
+class LoopRemarksHandler: public llvm::DiagnosticHandler {
+private:
+    static bool isLoopPass(llvm::StringRef passName) {
+        return passName == "loop-unroll" || passName == "loop-vectorize" || passName == "transform-warning";
+    }
+
+public:
+    bool handleDiagnostics(const llvm::DiagnosticInfo &diagnosticInfo) override {
+        const llvm::DiagnosticInfoOptimizationBase *remark = llvm::dyn_cast<llvm::DiagnosticInfoOptimizationBase>(&diagnosticInfo);
+        if (remark == nullptr || !isLoopPass(remark->getPassName()))
+            return false;
+
+        cout << format("🔁 {} in \"{}\": {}", string(remark->getPassName()), string(remark->getFunction().getName()), remark->getMsg()) << endl;
+        return true;
+    }
+
+    bool isAnalysisRemarkEnabled(llvm::StringRef passName) const override {
+        return isLoopPass(passName);
+    }
+
+    bool isMissedOptRemarkEnabled(llvm::StringRef passName) const override {
+        return isLoopPass(passName);
+    }
+
+    bool isPassedOptRemarkEnabled(llvm::StringRef passName) const override {
+        return isLoopPass(passName);
+    }
+
+    bool isAnyRemarkEnabled() const override {
+        return true;
+    }
+};
+
 CodeGenerator::CodeGenerator(
     string targetTripleOption,
     string architectureOption,
@@ -107,6 +142,7 @@ CodeGenerator::CodeGenerator(
     targetOptions.FunctionSections = (optionBits >> int(Options::FUNCTION_SECTIONS)) & 0x01;
     targetOptions.NoZerosInBSS = (optionBits >> int(Options::NO_BSS)) & 0x01;
     targetOptions.EmitStackSizeSection = (optionBits >> int(Options::STACK_SIZES)) & 0x01;
+    isLoopRemarksEnabled = (optionBits >> int(Options::LOOP_REMARKS)) & 0x01;
 
     targetMachine = target->createTargetMachine(
         targetTriple,
@@ -158,13 +194,17 @@ void CodeGenerator::generateObjectFile(shared_ptr<llvm::Module> module, OutputKi
     llvm::CGSCCAnalysisManager cgsccAnalysisManager;
     llvm::ModuleAnalysisManager moduleAnalysisManager;
 
-    llvm::PassBuilder passBuilder;
+    // target machine provides the costs and vector registers for the loop passes
+    llvm::PassBuilder passBuilder(targetMachine);
     passBuilder.registerModuleAnalyses(moduleAnalysisManager);
     passBuilder.registerCGSCCAnalyses(cgsccAnalysisManager);
     passBuilder.registerFunctionAnalyses(functionAnalysisManager);
     passBuilder.registerLoopAnalyses(loopAnalysisManager);
     passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cgsccAnalysisManager, moduleAnalysisManager);
 
+    if (isLoopRemarksEnabled)
+        module->getContext().setDiagnosticHandler(make_unique<LoopRemarksHandler>());
+
     llvm::ModulePassManager passManager = passBuilder.buildPerModuleDefaultPipeline(passOptimizationLevel);
     passManager.run(*module, moduleAnalysisManager);
 
@@ -192,6 +232,10 @@ int CodeGenerator::getPointerSize() {
     return dataLayout.getPointerSizeInBits();
 }
 
+llvm::DataLayout CodeGenerator::getDataLayout() {
+    return dataLayout;
+}
+
 llvm::Triple::ArchType CodeGenerator::getArchType() {
     return targetMachine->getTargetTriple().getArch();
 }
@@ -1,8 +1,11 @@
 #ifndef CODE_GENERATOR_H
 #define CODE_GENERATOR_H
 
+#include <format>
 #include <iostream>
 
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/IR/DiagnosticInfo.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Passes/PassBuilder.h>
@@ -45,7 +48,8 @@ public:
     enum class Options {
         FUNCTION_SECTIONS,
         NO_BSS,
-        STACK_SIZES
+        STACK_SIZES,
+        LOOP_REMARKS
     };
 
 
@@ -62,6 +66,7 @@ private:
     llvm::DataLayout dataLayout;
     llvm::CallingConv::ID callingConvention;
     llvm::OptimizationLevel passOptimizationLevel;
+    bool isLoopRemarksEnabled;
 
 public:
     CodeGenerator(
@@ -76,6 +81,7 @@ public:
     void generateObjectFile(shared_ptr<llvm::Module> module, OutputKind outputKind, bool isVerbose);
     int getIntSize();
     int getPointerSize();
+    llvm::DataLayout getDataLayout();
     llvm::Triple::ArchType getArchType();
     llvm::CallingConv::ID getCallingConvetion();
 };
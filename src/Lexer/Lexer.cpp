@@ -248,6 +248,9 @@ shared_ptr<Token> Lexer::nextToken() {
     if (token = match(TokenKind::DATA, "data", true))
         return token;
 
+    if (token = match(TokenKind::VEC, "vec", true))
+        return token;
+
     if (token = match(TokenKind::BLOB, "blob", true))
         return token;
 
@@ -260,6 +263,9 @@ shared_ptr<Token> Lexer::nextToken() {
     if (token = match(TokenKind::PTR, "ptr", true))
         return token;
 
+    if (token = match(TokenKind::REF, "ref", true))
+        return token;
+
     if (token = match(TokenKind::RETURN, "ret", true))
         return token;
 
@@ -318,6 +324,51 @@ shared_ptr<Token> Lexer::nextToken() {
     if (token = match(TokenKind::M_EXTERN, "@extern", true))
         return token;
 
+    if (token = match(TokenKind::M_UNINIT, "@uninit", true))
+        return token;
+
+    if (token = match(TokenKind::M_INLINE, "@inline", true))
+        return token;
+
+    if (token = match(TokenKind::M_CONST, "@const", true))
+        return token;
+
+    if (token = match(TokenKind::M_UNROLL, "@unroll", true))
+        return token;
+
+    if (token = match(TokenKind::M_NOUNROLL, "@nounroll", true))
+        return token;
+
+    if (token = match(TokenKind::M_VECTORIZE, "@vectorize", true))
+        return token;
+
+    if (token = match(TokenKind::M_PARALLEL, "@parallel", true))
+        return token;
+
+    if (token = match(TokenKind::M_ALIGN, "@align", true))
+        return token;
+
+    if (token = match(TokenKind::M_LIKELY, "@likely", true))
+        return token;
+
+    if (token = match(TokenKind::M_UNLIKELY, "@unlikely", true))
+        return token;
+
+    if (token = match(TokenKind::M_COLD, "@cold", true))
+        return token;
+
+    if (token = match(TokenKind::M_NOINLINE, "@noinline", true))
+        return token;
+
+    if (token = match(TokenKind::M_HOT, "@hot", true))
+        return token;
+
+    if (token = match(TokenKind::M_PURE, "@pure", true))
+        return token;
+
+    if (token = match(TokenKind::M_NOALIAS, "@noalias", true))
+        return token;
+
     if (token = match(TokenKind::META, "@", false))
         return token;
 
@@ -549,7 +600,7 @@ shared_ptr<Token> Lexer::matchIdentifier() {
         || lexme.compare("s8") == 0 || lexme.compare("s16") == 0 || lexme.compare("s32") == 0 || lexme.compare("s64") == 0
         || lexme.compare("f32") == 0 || lexme.compare("f64") == 0
         || lexme.compare("a") == 0 || lexme.compare("ptr") == 0
-        || lexme.compare("data") == 0 || lexme.compare("blob") == 0 || lexme.compare("proto") == 0 || lexme.compare("boxed") == 0
+        || lexme.compare("data") == 0 || lexme.compare("vec") == 0 || lexme.compare("blob") == 0 || lexme.compare("proto") == 0 || lexme.compare("boxed") == 0
     ){
         shared_ptr<Token> token = make_shared<Token>(TokenKind::TYPE, lexme, make_shared<Location>(currentFileName, currentLine, currentColumn));
         advanceWithToken(token);
@@ -52,10 +52,12 @@ enum class TokenKind {
     RAW_FUNCTION,
     RAW_SOURCE_LINE,
     DATA,
+    VEC,
     BLOB,
     PROTO,
     BOXED,
     PTR,
+    REF,
     RETURN,
     REPEAT,
     IF,
@@ -75,6 +77,21 @@ enum class TokenKind {
     M_IMPORT,
     M_EXPORT,
     M_EXTERN,
+    M_UNINIT,
+    M_INLINE,
+    M_CONST,
+    M_UNROLL,
+    M_NOUNROLL,
+    M_VECTORIZE,
+    M_PARALLEL,
+    M_ALIGN,
+    M_LIKELY,
+    M_UNLIKELY,
+    M_COLD,
+    M_NOINLINE,
+    M_HOT,
+    M_PURE,
+    M_NOALIAS,
     META,
 
     NEW_LINE,
@@ -136,6 +136,8 @@ string Logger::toString(shared_ptr<Token> token) {
             return "TYPE(" + token->getLexme() + ")";
         case TokenKind::DATA:
             return "DATA";
+        case TokenKind::VEC:
+            return "VEC";
         case TokenKind::BLOB:
             return "BLOB";
         case TokenKind::PROTO:
@@ -144,6 +146,8 @@ string Logger::toString(shared_ptr<Token> token) {
             return "BOXED";
         case TokenKind::PTR:
             return "PTR";
+        case TokenKind::REF:
+            return "REF";
         case TokenKind::RAW_SOURCE_LINE:
             return format("RAW_SOURCE_LINE({})", token->getLexme());
 
@@ -168,6 +172,36 @@ string Logger::toString(shared_ptr<Token> token) {
             return "@EXPORT";
         case TokenKind::M_EXTERN:
             return "@EXTERN";
+        case TokenKind::M_UNINIT:
+            return "@UNINIT";
+        case TokenKind::M_INLINE:
+            return "@INLINE";
+        case TokenKind::M_CONST:
+            return "@CONST";
+        case TokenKind::M_UNROLL:
+            return "@UNROLL";
+        case TokenKind::M_NOUNROLL:
+            return "@NOUNROLL";
+        case TokenKind::M_VECTORIZE:
+            return "@VECTORIZE";
+        case TokenKind::M_PARALLEL:
+            return "@PARALLEL";
+        case TokenKind::M_ALIGN:
+            return "@ALIGN";
+        case TokenKind::M_LIKELY:
+            return "@LIKELY";
+        case TokenKind::M_UNLIKELY:
+            return "@UNLIKELY";
+        case TokenKind::M_COLD:
+            return "@COLD";
+        case TokenKind::M_NOINLINE:
+            return "@NOINLINE";
+        case TokenKind::M_HOT:
+            return "@HOT";
+        case TokenKind::M_PURE:
+            return "@PURE";
+        case TokenKind::M_NOALIAS:
+            return "@NOALIAS";
         case TokenKind::META:
             return "@";
 
@@ -321,7 +355,17 @@ string Logger::toString(shared_ptr<StatementFunction> statement, vector<IndentKi
     string line;
 
     // name
-    line = format("{}FUN `{}` → {}", (statement->getShouldExport() ? "@EXPORT " : ""), statement->getName(), toString(statement->getReturnValueType()));
+    line = format(
+        "{}{}{}{}{}{}FUN `{}` → {}",
+        (statement->getShouldExport() ? "@EXPORT " : ""),
+        (statement->getShouldInline() ? "@INLINE " : ""),
+        (statement->getIsNoInline() ? "@NOINLINE " : ""),
+        (statement->getIsHot() ? "@HOT " : ""),
+        (statement->getIsCold() ? "@COLD " : ""),
+        (statement->getIsPure() ? "@PURE " : ""),
+        statement->getName(),
+        toString(statement->getReturnValueType())
+    );
     if (!statement->getArguments().empty())
         line += ":";
     text += formattedLine(line, indents);
@@ -330,7 +374,7 @@ string Logger::toString(shared_ptr<StatementFunction> statement, vector<IndentKi
 
     // arguments
     for (pair<string, shared_ptr<ValueType>> arg : statement->getArguments()) {
-        line = format("`{}` {}", arg.first, toString(arg.second));
+        line = format("`{}` {}{}", arg.first, (statement->getNoAliasArgumentNames().contains(arg.first) ? "@NOALIAS " : ""), toString(arg.second));
         text += formattedLine(line, indents);
     }
 
@@ -345,7 +389,16 @@ string Logger::toString(shared_ptr<StatementFunctionDeclaration> statement, vect
     string line;
 
     // name
-    line = format("FUN DECL `{}` → {}", statement->getName(), toString(statement->getReturnValueType()));
+    line = format(
+        "{}{}{}{}{}FUN DECL `{}` → {}",
+        (statement->getShouldInline() ? "@INLINE " : ""),
+        (statement->getIsNoInline() ? "@NOINLINE " : ""),
+        (statement->getIsHot() ? "@HOT " : ""),
+        (statement->getIsCold() ? "@COLD " : ""),
+        (statement->getIsPure() ? "@PURE " : ""),
+        statement->getName(),
+        toString(statement->getReturnValueType())
+    );
     if (!statement->getArguments().empty())
         line += ":";
     text += formattedLine(line, indents);
@@ -354,7 +407,7 @@ string Logger::toString(shared_ptr<StatementFunctionDeclaration> statement, vect
 
     // arguments
     for (pair<string, shared_ptr<ValueType>> arg : statement->getArguments()) {
-        line = format("`{}` {}", arg.first, toString(arg.second));
+        line = format("`{}` {}{}", arg.first, (statement->getNoAliasArgumentNames().contains(arg.first) ? "@NOALIAS " : ""), toString(arg.second));
         text += formattedLine(line, indents);
     }
 
@@ -497,7 +550,19 @@ string Logger::toString(shared_ptr<StatementRepeat> statement, vector<IndentKind
     string line;
 
     // name
-    line = "REP";
+    if (optional<int> unrollCount = statement->getUnrollCount())
+        line += format("@UNROLL({}) ", *unrollCount);
+    if (statement->getIsNoUnroll())
+        line += "@NOUNROLL ";
+    if (optional<int> vectorizeWidth = statement->getVectorizeWidth()) {
+        optional<int> interleaveCount = statement->getInterleaveCount();
+        line += format("@VECTORIZE({}{}) ", *vectorizeWidth, interleaveCount ? format(", {}", *interleaveCount) : "");
+    }
+    if (statement->getIsParallel())
+        line += "@PARALLEL ";
+    if (optional<bool> isConditionLikely = statement->getIsConditionLikely())
+        line += *isConditionLikely ? "@LIKELY " : "@UNLIKELY ";
+    line += "REP";
     if (
         statement->getInitStatement() != nullptr
         || statement->getPreConditionExpression() != nullptr
@@ -555,7 +620,7 @@ string Logger::toString(shared_ptr<StatementVariable> statement, vector<IndentKi
     string line;
 
     // name
-    line = format("{}VAR `{}` {}", (statement->getShouldExport() ? "@EXPORT " : ""), statement->getIdentifier(), toString(statement->getValueType()));
+    line = format("{}{}{}{}VAR `{}` {}", (statement->getShouldExport() ? "@EXPORT " : ""), (statement->getIsConstant() ? "@CONST " : ""), (statement->getIsUninitialized() ? "@UNINIT " : ""), (statement->getAlignment() ? format("@ALIGN({}) ", *statement->getAlignment()) : ""), statement->getIdentifier(), toString(statement->getValueType()));
     if (statement->getExpression() != nullptr)
         line += ":";
     text += formattedLine(line, indents);
@@ -575,7 +640,7 @@ string Logger::toString(shared_ptr<StatementVariableDeclaration> statement, vect
     string line;
 
     // name
-    line = format("VAR DECL `{}` {}", statement->getIdentifier(), toString(statement->getValueType()));
+    line = format("{}VAR DECL `{}` {}", (statement->getIsConstant() ? "@CONST " : ""), statement->getIdentifier(), toString(statement->getValueType()));
     text += formattedLine(line, indents);
 
     return text;
@@ -777,7 +842,10 @@ string Logger::toString(shared_ptr<ExpressionIfElse> expression, vector<IndentKi
     string line;
 
     // name
-    text += formattedLine("IF", isInline ? vector<IndentKind>() : indents);
+    line = "IF";
+    if (optional<bool> isConditionLikely = expression->getIsConditionLikely())
+        line += *isConditionLikely ? " @LIKELY" : " @UNLIKELY";
+    text += formattedLine(line, isInline ? vector<IndentKind>() : indents);
     // Only the initial IF is inline
     if (isInline)
         text += "\n";
@@ -859,6 +927,8 @@ string Logger::toString(shared_ptr<ExpressionValue> expression, vector<IndentKin
     switch (expression->getValueKind()) {
         case ExpressionValueKind::BUILT_IN_ADR:
         case ExpressionValueKind::BUILT_IN_COUNT:
+        case ExpressionValueKind::BUILT_IN_INTRINSIC:
+        case ExpressionValueKind::BUILT_IN_REDUCTION:
         case ExpressionValueKind::BUILT_IN_SIZE:
         case ExpressionValueKind::BUILT_IN_VADR:
         case ExpressionValueKind::BUILT_IN_VAL_SIMPLE:
@@ -1060,6 +1130,8 @@ string Logger::toString(TokenKind tokenKind) {
             return "TYPE";
         case TokenKind::DATA:
             return "DATA";
+        case TokenKind::VEC:
+            return "VEC";
         case TokenKind::BLOB:
             return "BLOB";
         case TokenKind::PROTO:
@@ -1068,6 +1140,8 @@ string Logger::toString(TokenKind tokenKind) {
             return "BOXED";
         case TokenKind::PTR:
             return "PTR";
+        case TokenKind::REF:
+            return "REF";
         case TokenKind::RAW_SOURCE_LINE:
             return "RAW_SOURCE_LINE";
 
@@ -1092,6 +1166,36 @@ string Logger::toString(TokenKind tokenKind) {
             return "@EXPORT";
         case TokenKind::M_EXTERN:
             return "@EXTERN";
+        case TokenKind::M_UNINIT:
+            return "@UNINIT";
+        case TokenKind::M_INLINE:
+            return "@INLINE";
+        case TokenKind::M_CONST:
+            return "@CONST";
+        case TokenKind::M_UNROLL:
+            return "@UNROLL";
+        case TokenKind::M_NOUNROLL:
+            return "@NOUNROLL";
+        case TokenKind::M_VECTORIZE:
+            return "@VECTORIZE";
+        case TokenKind::M_PARALLEL:
+            return "@PARALLEL";
+        case TokenKind::M_ALIGN:
+            return "@ALIGN";
+        case TokenKind::M_LIKELY:
+            return "@LIKELY";
+        case TokenKind::M_UNLIKELY:
+            return "@UNLIKELY";
+        case TokenKind::M_COLD:
+            return "@COLD";
+        case TokenKind::M_NOINLINE:
+            return "@NOINLINE";
+        case TokenKind::M_HOT:
+            return "@HOT";
+        case TokenKind::M_PURE:
+            return "@PURE";
+        case TokenKind::M_NOALIAS:
+            return "@NOALIAS";
         case TokenKind::META:
             return "@";
 
@@ -1313,6 +1417,8 @@ string Logger::toString(shared_ptr<ValueType> valueType) {
             else
                 return format("DATA<{}>", toString(valueType->getSubType()));
         }
+        case ValueTypeKind::VEC:
+            return format("VEC<{}, {}>", toString(valueType->getSubType()), toString(valueType->getCountExpression(), {}, false));
         case ValueTypeKind::BLOB: {
             string text;
             text += format("BLOB<`{}`", *valueType->getBlobName());
@@ -1336,6 +1442,8 @@ string Logger::toString(shared_ptr<ValueType> valueType) {
             for (int i=0; i<argumentTypes.size(); i++) {
                 if (i > 0)
                     text += ",";
+                if (argumentTypes.at(i)->isReference())
+                    text += " REF";
                 text += format(" {}", toString(argumentTypes.at(i)));
             }
             // return
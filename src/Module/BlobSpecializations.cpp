@@ -0,0 +1,99 @@
+#include "BlobSpecializations.h"
+
+#include "Parser/ValueType.h"
+
+//
+// Public
+//
+void BlobSpecializations::addTypeArguments(string qualifiedBlobName, vector<shared_ptr<ValueType>> typeArguments) {
+    // arguments that can't be specialized stay erased
+    optional<string> name = specializedName(qualifiedBlobName, typeArguments);
+    if (!name)
+        return;
+
+    lock_guard<mutex> lock(typeArgumentsMutex);
+    typeArgumentsMap[qualifiedBlobName].try_emplace(*name, typeArguments);
+}
+
+vector<vector<shared_ptr<ValueType>>> BlobSpecializations::getTypeArguments(string qualifiedBlobName) {
+    vector<vector<shared_ptr<ValueType>>> typeArgumentsList;
+
+    lock_guard<mutex> lock(typeArgumentsMutex);
+    auto it = typeArgumentsMap.find(qualifiedBlobName);
+    if (it == typeArgumentsMap.end())
+        return typeArgumentsList;
+
+    for (auto &typeArguments : it->second)
+        typeArgumentsList.push_back(typeArguments.second);
+    return typeArgumentsList;
+}
+
+bool BlobSpecializations::hasTypeArguments(string qualifiedBlobName, vector<shared_ptr<ValueType>> typeArguments) {
+    optional<string> name = specializedName(qualifiedBlobName, typeArguments);
+    if (!name)
+        return false;
+
+    lock_guard<mutex> lock(typeArgumentsMutex);
+    auto it = typeArgumentsMap.find(qualifiedBlobName);
+    return it != typeArgumentsMap.end() && it->second.contains(*name);
+}
+
+optional<string> BlobSpecializations::mangledName(shared_ptr<ValueType> valueType) {
+    if (valueType == nullptr)
+        return {};
+
+    // signedness changes casts, divisions and comparisons, so each number type gets its own copy
+    switch (valueType->getKind()) {
+        case ValueTypeKind::BOOL:
+            return "bool";
+        case ValueTypeKind::U8:
+            return "u8";
+        case ValueTypeKind::U16:
+            return "u16";
+        case ValueTypeKind::U32:
+            return "u32";
+        case ValueTypeKind::U64:
+            return "u64";
+        case ValueTypeKind::UINT:
+            return "uint";
+        case ValueTypeKind::S8:
+            return "s8";
+        case ValueTypeKind::S16:
+            return "s16";
+        case ValueTypeKind::S32:
+            return "s32";
+        case ValueTypeKind::S64:
+            return "s64";
+        case ValueTypeKind::SINT:
+            return "sint";
+        case ValueTypeKind::FLOAT:
+            return "float";
+        case ValueTypeKind::F32:
+            return "f32";
+        case ValueTypeKind::F64:
+            return "f64";
+        // boxed pointers can't be dereferenced, so the pointee doesn't change the generated code
+        case ValueTypeKind::A:
+        case ValueTypeKind::PTR:
+            return "ptr";
+        default:
+            return {};
+    }
+}
+
+optional<string> BlobSpecializations::specializedName(string blobName, vector<shared_ptr<ValueType>> typeArguments) {
+    if (typeArguments.empty())
+        return {};
+
+    string argumentsName;
+    for (shared_ptr<ValueType> &typeArgument : typeArguments) {
+        optional<string> argumentName = mangledName(typeArgument);
+        if (!argumentName)
+            return {};
+        if (!argumentsName.empty())
+            argumentsName += ",";
+        argumentsName += *argumentName;
+    }
+
+    return format("{}<{}>", blobName, argumentsName);
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef BLOB_SPECIALIZATIONS_H
+#define BLOB_SPECIALIZATIONS_H
+
+#include <format>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+class ValueType;
+
+using namespace std;
+
+// Type arguments used with the generic blobs across all the modules.
+// Each module builds the specialized copies of its own generic blobs, so other modules
+// can call them by symbol. Pointers to different types share a single copy.
+class BlobSpecializations {
+private:
+    mutex typeArgumentsMutex;
+    map<string, map<string, vector<shared_ptr<ValueType>>>> typeArgumentsMap;
+
+public:
+    void addTypeArguments(string qualifiedBlobName, vector<shared_ptr<ValueType>> typeArguments);
+    vector<vector<shared_ptr<ValueType>>> getTypeArguments(string qualifiedBlobName);
+    bool hasTypeArguments(string qualifiedBlobName, vector<shared_ptr<ValueType>> typeArguments);
+
+    static optional<string> mangledName(shared_ptr<ValueType> valueType);
+    static optional<string> specializedName(string blobName, vector<shared_ptr<ValueType>> typeArguments);
+};
+
+#endif
\ No newline at end of file
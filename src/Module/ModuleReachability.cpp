@@ -0,0 +1,220 @@
+#include "ModuleReachability.h"
+
+#include "Module.h"
+
+#include "Parser/Expression/ExpressionBinary.h"
+#include "Parser/Expression/ExpressionBlock.h"
+#include "Parser/Expression/ExpressionCall.h"
+#include "Parser/Expression/ExpressionChained.h"
+#include "Parser/Expression/ExpressionCompositeLiteral.h"
+#include "Parser/Expression/ExpressionGrouping.h"
+#include "Parser/Expression/ExpressionIfElse.h"
+#include "Parser/Expression/ExpressionUnary.h"
+#include "Parser/Expression/ExpressionValue.h"
+
+#include "Parser/Statement/StatementAssignment.h"
+#include "Parser/Statement/StatementBlob.h"
+#include "Parser/Statement/StatementBlock.h"
+#include "Parser/Statement/StatementExpression.h"
+#include "Parser/Statement/StatementFunction.h"
+#include "Parser/Statement/StatementRepeat.h"
+#include "Parser/Statement/StatementReturn.h"
+#include "Parser/Statement/StatementVariable.h"
+
+ModuleReachability::ModuleReachability(shared_ptr<Module> module) {
+    vector<shared_ptr<StatementFunction>> rootFunctions;
+
+    // blob member functions
+    for (shared_ptr<Statement> &headerStatement : module->getHeaderStatements()) {
+        switch (headerStatement->getKind()) {
+            case StatementKind::BLOB: {
+                shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(headerStatement);
+                // exported blobs can be used by other modules and proto conforming ones are called indirectly
+                bool isRoot = statementBlob->getShouldExport() || !statementBlob->getProtoNames().empty();
+                for (shared_ptr<StatementFunction> &statementFunction : statementBlob->getFunctionStatements()) {
+                    functionsForNameMap[memberName(statementFunction->getName())].push_back(statementFunction);
+                    if (isRoot)
+                        rootFunctions.push_back(statementFunction);
+                }
+                break;
+            }
+            case StatementKind::VARIABLE: {
+                // globals are always built, so anything used by their initializers is reachable
+                collectNames(headerStatement);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // body functions
+    for (shared_ptr<Statement> &bodyStatement : module->getBodyStatements()) {
+        shared_ptr<StatementFunction> statementFunction = dynamic_pointer_cast<StatementFunction>(bodyStatement);
+        if (statementFunction == nullptr)
+            continue;
+
+        functionsForNameMap[statementFunction->getName()].push_back(statementFunction);
+        if (statementFunction->getShouldExport() || statementFunction->getName().compare("main") == 0)
+            rootFunctions.push_back(statementFunction);
+    }
+
+    for (shared_ptr<StatementFunction> &rootFunction : rootFunctions)
+        markFunctionReachable(rootFunction);
+
+    // walk the call graph
+    while (!pendingFunctions.empty()) {
+        shared_ptr<StatementFunction> statementFunction = pendingFunctions.back();
+        pendingFunctions.pop_back();
+        collectNames(statementFunction->getStatementBlock());
+    }
+}
+
+//
+// Public
+//
+bool ModuleReachability::isFunctionReachable(string name) {
+    return reachableFunctionNames.contains(name);
+}
+
+bool ModuleReachability::isImportedSymbolReferenced(string moduleName, string name) {
+    // blob member functions
+    if (name.find('.', 0) != string::npos)
+        return referencedNames.contains(memberName(name));
+
+    return referencedNames.contains(format("{}.{}", moduleName, name));
+}
+
+//
+// Support
+//
+void ModuleReachability::markFunctionReachable(shared_ptr<StatementFunction> statementFunction) {
+    if (reachableFunctionNames.contains(statementFunction->getName()))
+        return;
+
+    reachableFunctionNames.insert(statementFunction->getName());
+    pendingFunctions.push_back(statementFunction);
+}
+
+void ModuleReachability::markNameReferenced(string name) {
+    if (referencedNames.contains(name))
+        return;
+
+    referencedNames.insert(name);
+    auto it = functionsForNameMap.find(name);
+    if (it == functionsForNameMap.end())
+        return;
+
+    for (shared_ptr<StatementFunction> &statementFunction : it->second)
+        markFunctionReachable(statementFunction);
+}
+
+void ModuleReachability::collectNames(shared_ptr<Statement> statement) {
+    if (statement == nullptr)
+        return;
+
+    switch (statement->getKind()) {
+        case StatementKind::ASSIGNMENT: {
+            shared_ptr<StatementAssignment> statementAssignment = dynamic_pointer_cast<StatementAssignment>(statement);
+            collectNames(statementAssignment->getExpressionChained());
+            collectNames(statementAssignment->getValueExpression());
+            break;
+        }
+        case StatementKind::BLOCK: {
+            for (shared_ptr<Statement> &innerStatement : dynamic_pointer_cast<StatementBlock>(statement)->getStatements())
+                collectNames(innerStatement);
+            break;
+        }
+        case StatementKind::EXPRESSION: {
+            collectNames(dynamic_pointer_cast<StatementExpression>(statement)->getExpression());
+            break;
+        }
+        case StatementKind::REPEAT: {
+            shared_ptr<StatementRepeat> statementRepeat = dynamic_pointer_cast<StatementRepeat>(statement);
+            collectNames(statementRepeat->getInitStatement());
+            collectNames(statementRepeat->getPostStatement());
+            collectNames(statementRepeat->getPreConditionExpression());
+            collectNames(statementRepeat->getPostConditionExpression());
+            collectNames(statementRepeat->getBodyBlockStatement());
+            break;
+        }
+        case StatementKind::RETURN: {
+            collectNames(dynamic_pointer_cast<StatementReturn>(statement)->getExpression());
+            break;
+        }
+        case StatementKind::VARIABLE: {
+            collectNames(dynamic_pointer_cast<StatementVariable>(statement)->getExpression());
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void ModuleReachability::collectNames(shared_ptr<Expression> expression) {
+    if (expression == nullptr)
+        return;
+
+    switch (expression->getKind()) {
+        case ExpressionKind::BINARY: {
+            shared_ptr<ExpressionBinary> expressionBinary = dynamic_pointer_cast<ExpressionBinary>(expression);
+            collectNames(expressionBinary->getLeft());
+            collectNames(expressionBinary->getRight());
+            break;
+        }
+        case ExpressionKind::BLOCK: {
+            shared_ptr<ExpressionBlock> expressionBlock = dynamic_pointer_cast<ExpressionBlock>(expression);
+            collectNames(expressionBlock->getStatementBlock());
+            collectNames(expressionBlock->getResultStatementExpression());
+            break;
+        }
+        case ExpressionKind::CALL: {
+            shared_ptr<ExpressionCall> expressionCall = dynamic_pointer_cast<ExpressionCall>(expression);
+            markNameReferenced(expressionCall->getName());
+            for (shared_ptr<Expression> &argumentExpression : expressionCall->getArgumentExpressions())
+                collectNames(argumentExpression);
+            break;
+        }
+        case ExpressionKind::CHAINED: {
+            for (shared_ptr<Expression> &chainExpression : dynamic_pointer_cast<ExpressionChained>(expression)->getChainExpressions())
+                collectNames(chainExpression);
+            break;
+        }
+        case ExpressionKind::COMPOSITE_LITERAL: {
+            for (shared_ptr<Expression> &elementExpression : dynamic_pointer_cast<ExpressionCompositeLiteral>(expression)->getExpressions())
+                collectNames(elementExpression);
+            break;
+        }
+        case ExpressionKind::GROUPING: {
+            collectNames(dynamic_pointer_cast<ExpressionGrouping>(expression)->getSubExpression());
+            break;
+        }
+        case ExpressionKind::IF_ELSE: {
+            shared_ptr<ExpressionIfElse> expressionIfElse = dynamic_pointer_cast<ExpressionIfElse>(expression);
+            collectNames(expressionIfElse->getConditionExpression());
+            collectNames(expressionIfElse->getThenExpression());
+            collectNames(expressionIfElse->getElseExpression());
+            break;
+        }
+        case ExpressionKind::UNARY: {
+            collectNames(dynamic_pointer_cast<ExpressionUnary>(expression)->getSubExpression());
+            break;
+        }
+        case ExpressionKind::VALUE: {
+            // functions can also be referenced by value (for example as callbacks)
+            shared_ptr<ExpressionValue> expressionValue = dynamic_pointer_cast<ExpressionValue>(expression);
+            markNameReferenced(expressionValue->getIdentifier());
+            collectNames(expressionValue->getIndexExpression());
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+string ModuleReachability::memberName(string name) {
+    size_t dotIndex = name.rfind('.');
+    if (dotIndex == string::npos)
+        return name;
+    return name.substr(dotIndex + 1);
+}
\ No newline at end of file
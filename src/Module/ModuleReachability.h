@@ -0,0 +1,43 @@
+#ifndef MODULE_REACHABILITY_H
+#define MODULE_REACHABILITY_H
+
+#include <format>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class Module;
+class Statement;
+class StatementFunction;
+class Expression;
+
+using namespace std;
+
+// Finds functions that can be reached from the exported symbols and main,
+// by following the names referenced in the function bodies.
+// Blob member calls are resolved by member name only, so the result is conservative.
+class ModuleReachability {
+private:
+    map<string, vector<shared_ptr<StatementFunction>>> functionsForNameMap;
+    set<string> referencedNames;
+    set<string> reachableFunctionNames;
+    vector<shared_ptr<StatementFunction>> pendingFunctions;
+
+    void markFunctionReachable(shared_ptr<StatementFunction> statementFunction);
+    void markNameReferenced(string name);
+
+    void collectNames(shared_ptr<Statement> statement);
+    void collectNames(shared_ptr<Expression> expression);
+
+    static string memberName(string name);
+
+public:
+    ModuleReachability(shared_ptr<Module> module);
+
+    bool isFunctionReachable(string name);
+    bool isImportedSymbolReferenced(string moduleName, string name);
+};
+
+#endif
\ No newline at end of file
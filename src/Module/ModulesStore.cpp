@@ -2,15 +2,31 @@
 
 #include "Module.h"
 
+#include "Parser/Expression/ExpressionBinary.h"
+#include "Parser/Expression/ExpressionBlock.h"
+#include "Parser/Expression/ExpressionCall.h"
+#include "Parser/Expression/ExpressionChained.h"
+#include "Parser/Expression/ExpressionCompositeLiteral.h"
+#include "Parser/Expression/ExpressionGrouping.h"
+#include "Parser/Expression/ExpressionIfElse.h"
+#include "Parser/Expression/ExpressionUnary.h"
+#include "Parser/Expression/ExpressionValue.h"
+
 #include "Parser/Statement/StatementModule.h"
+#include "Parser/Statement/StatementAssignment.h"
 #include "Parser/Statement/StatementBlob.h"
 #include "Parser/Statement/StatementBlobDeclaration.h"
+#include "Parser/Statement/StatementBlock.h"
+#include "Parser/Statement/StatementExpression.h"
 #include "Parser/Statement/StatementFunction.h"
 #include "Parser/Statement/StatementFunctionDeclaration.h"
+#include "Parser/Statement/StatementMetaExternFunction.h"
 #include "Parser/Statement/StatementMetaImport.h"
 #include "Parser/Statement/StatementProto.h"
 #include "Parser/Statement/StatementProtoDeclaration.h"
 #include "Parser/Statement/StatementRawFunction.h"
+#include "Parser/Statement/StatementRepeat.h"
+#include "Parser/Statement/StatementReturn.h"
 #include "Parser/Statement/StatementVariable.h"
 #include "Parser/Statement/StatementVariableDeclaration.h"
 #include "Parser/ValueType.h"
@@ -27,7 +43,14 @@ shared_ptr<ValueType> ModulesStore::typeForExportedStatementFromType(shared_ptr<
             if (name.find('.', 0) == string::npos && defaultModuleName.compare(moduleName) != 0) {
                 name = moduleName + "." + name;
             }
-            return ValueType::blob(name, {});
+            // keep the type arguments, so importers see the same blob
+            optional<vector<shared_ptr<ValueType>>> namedTypeValues;
+            if (valueType->getNamedTypeValues()) {
+                namedTypeValues = vector<shared_ptr<ValueType>>();
+                for (shared_ptr<ValueType> namedTypeValue : *valueType->getNamedTypeValues())
+                    namedTypeValues->push_back(typeForExportedStatementFromType(namedTypeValue, moduleName));
+            }
+            return ValueType::blob(name, namedTypeValues);
         }
         case ValueTypeKind::DATA:
             return ValueType::data(typeForExportedStatementFromType(valueType->getSubType(), moduleName), valueType->getCountExpression());
@@ -36,7 +59,7 @@ shared_ptr<ValueType> ModulesStore::typeForExportedStatementFromType(shared_ptr<
             vector<shared_ptr<ValueType>> argumentTypes = *(valueType->getArgumentTypes());
             vector<shared_ptr<ValueType>> exportedArgumentTypes;
             for (shared_ptr<ValueType> argumentType : argumentTypes)
-                exportedArgumentTypes.push_back(typeForExportedStatementFromType(argumentType, moduleName));
+                exportedArgumentTypes.push_back(typeForExportedArgumentFromType(argumentType, moduleName));
             // then the return type
             shared_ptr<ValueType> exportedReturnType = typeForExportedStatementFromType(valueType->getReturnType(), moduleName);
             // and finally return a new function type
@@ -58,6 +81,257 @@ shared_ptr<ValueType> ModulesStore::typeForExportedStatementFromType(shared_ptr<
     }
 }
 
+shared_ptr<ValueType> ModulesStore::typeForExportedArgumentFromType(shared_ptr<ValueType> valueType, string moduleName) {
+    shared_ptr<ValueType> exportedValueType = typeForExportedStatementFromType(valueType, moduleName);
+    // keep the passing mode of the argument
+    if (valueType->isReference() && !exportedValueType->isReference())
+        exportedValueType = ValueType::reference(exportedValueType);
+    return exportedValueType;
+}
+
+bool ModulesStore::isFoldable(shared_ptr<ValueType> valueType) {
+    switch (valueType->getKind()) {
+        case ValueTypeKind::DATA:
+        case ValueTypeKind::PTR:
+            return isFoldable(valueType->getSubType());
+        case ValueTypeKind::BLOB:
+        case ValueTypeKind::PROTO:
+        case ValueTypeKind::BOXED:
+        case ValueTypeKind::FUN:
+        case ValueTypeKind::COMPOSITE:
+        case ValueTypeKind::NAMED_TYPE:
+            return false;
+        default:
+            return true;
+    }
+}
+
+vector<shared_ptr<Statement>> ModulesStore::exportedInlineStatements(string moduleName) {
+    InlineNames names;
+
+    // exported symbols get declared by the importer, so they can be referenced by the bodies
+    for (shared_ptr<Statement> &statement : exportedProtoDeclarationStatementsMap[moduleName])
+        names.typeNames.insert(dynamic_pointer_cast<StatementProtoDeclaration>(statement)->getName());
+    for (shared_ptr<Statement> &statement : exportedBlobDeclarationStatementsMap[moduleName])
+        names.typeNames.insert(dynamic_pointer_cast<StatementBlobDeclaration>(statement)->getName());
+    for (shared_ptr<Statement> &statement : exportedVariableDeclarationStatementsMap[moduleName])
+        names.variableNames.insert(dynamic_pointer_cast<StatementVariableDeclaration>(statement)->getIdentifier());
+    for (shared_ptr<Statement> &statement : exportedFunctionDeclarationStatementsMap[moduleName])
+        names.functionNames.insert(dynamic_pointer_cast<StatementFunctionDeclaration>(statement)->getName());
+
+    // and so can be the foreign functions
+    for (shared_ptr<Statement> &statement : externStatementsMap[moduleName]) {
+        if (shared_ptr<StatementMetaExternFunction> statementMetaExternFunction = dynamic_pointer_cast<StatementMetaExternFunction>(statement))
+            names.externStatementsMap[statementMetaExternFunction->getName()] = statement;
+    }
+
+    // exported functions and members of exported blobs
+    vector<shared_ptr<StatementFunction>> statementFunctions;
+    for (shared_ptr<Statement> &statement : blobStatementsMap[moduleName]) {
+        shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(statement);
+        // calls on protos can be resolved to a blob which the importer doesn't know about
+        if (!statementBlob->getShouldExport() && !statementBlob->getProtoNames().empty())
+            return {};
+        // generic members are built for each of the specializations instead
+        if (!statementBlob->getShouldExport() || !statementBlob->getNamedTypeKeys().empty())
+            continue;
+        for (shared_ptr<StatementFunction> &statementFunction : statementBlob->getFunctionStatements())
+            statementFunctions.push_back(statementFunction);
+    }
+    for (shared_ptr<Statement> &statement : bodyStatementsMap[moduleName]) {
+        shared_ptr<StatementFunction> statementFunction = dynamic_pointer_cast<StatementFunction>(statement);
+        if (statementFunction != nullptr && statementFunction->getShouldExport())
+            statementFunctions.push_back(statementFunction);
+    }
+
+    // include the ones which are either marked with @inline or are small enough
+    vector<shared_ptr<Statement>> inlineFunctionStatements;
+    for (shared_ptr<StatementFunction> &statementFunction : statementFunctions) {
+        set<string> referencedExternNames = names.referencedExternNames;
+        names.localNames = {"it"};
+        names.statementsCount = 0;
+
+        bool isEligible = isInlinable(statementFunction->getReturnValueType(), names);
+        for (pair<string, shared_ptr<ValueType>> &argument : statementFunction->getArguments()) {
+            names.localNames.insert(argument.first);
+            isEligible = isEligible && isInlinable(argument.second, names);
+        }
+        isEligible = isEligible && isInlinable(statementFunction->getStatementBlock(), names);
+
+        if (isEligible && (statementFunction->getShouldInline() || names.statementsCount <= MAX_INLINE_STATEMENTS_COUNT))
+            inlineFunctionStatements.push_back(statementFunction);
+        else
+            names.referencedExternNames = referencedExternNames;
+    }
+
+    // foreign functions used by the bodies go first
+    vector<shared_ptr<Statement>> statements;
+    for (const string &externName : names.referencedExternNames)
+        statements.push_back(names.externStatementsMap[externName]);
+    for (shared_ptr<Statement> &statement : inlineFunctionStatements)
+        statements.push_back(statement);
+
+    return statements;
+}
+
+bool ModulesStore::isInlinable(shared_ptr<Statement> statement, InlineNames &names) {
+    if (statement == nullptr)
+        return true;
+
+    if (statement->getKind() != StatementKind::BLOCK)
+        names.statementsCount++;
+
+    switch (statement->getKind()) {
+        case StatementKind::ASSIGNMENT: {
+            shared_ptr<StatementAssignment> statementAssignment = dynamic_pointer_cast<StatementAssignment>(statement);
+            return isInlinable(statementAssignment->getExpressionChained(), names, false) &&
+                isInlinable(statementAssignment->getValueExpression(), names, false);
+        }
+        case StatementKind::BLOCK: {
+            for (shared_ptr<Statement> &innerStatement : dynamic_pointer_cast<StatementBlock>(statement)->getStatements()) {
+                if (!isInlinable(innerStatement, names))
+                    return false;
+            }
+            return true;
+        }
+        case StatementKind::EXPRESSION: {
+            return isInlinable(dynamic_pointer_cast<StatementExpression>(statement)->getExpression(), names, false);
+        }
+        case StatementKind::REPEAT: {
+            shared_ptr<StatementRepeat> statementRepeat = dynamic_pointer_cast<StatementRepeat>(statement);
+            return isInlinable(statementRepeat->getInitStatement(), names) &&
+                isInlinable(statementRepeat->getPostStatement(), names) &&
+                isInlinable(statementRepeat->getPreConditionExpression(), names, false) &&
+                isInlinable(statementRepeat->getPostConditionExpression(), names, false) &&
+                isInlinable(statementRepeat->getBodyBlockStatement(), names);
+        }
+        case StatementKind::RETURN: {
+            return isInlinable(dynamic_pointer_cast<StatementReturn>(statement)->getExpression(), names, false);
+        }
+        case StatementKind::VARIABLE: {
+            shared_ptr<StatementVariable> statementVariable = dynamic_pointer_cast<StatementVariable>(statement);
+            names.localNames.insert(statementVariable->getIdentifier());
+            return isInlinable(statementVariable->getValueType(), names) &&
+                isInlinable(statementVariable->getExpression(), names, false);
+        }
+        default:
+            return false;
+    }
+}
+
+bool ModulesStore::isInlinable(shared_ptr<Expression> expression, InlineNames &names, bool isMember) {
+    if (expression == nullptr)
+        return true;
+
+    switch (expression->getKind()) {
+        case ExpressionKind::BINARY: {
+            shared_ptr<ExpressionBinary> expressionBinary = dynamic_pointer_cast<ExpressionBinary>(expression);
+            return isInlinable(expressionBinary->getLeft(), names, false) &&
+                isInlinable(expressionBinary->getRight(), names, false);
+        }
+        case ExpressionKind::BLOCK: {
+            shared_ptr<ExpressionBlock> expressionBlock = dynamic_pointer_cast<ExpressionBlock>(expression);
+            return isInlinable(expressionBlock->getStatementBlock(), names) &&
+                isInlinable(expressionBlock->getResultStatementExpression(), names);
+        }
+        case ExpressionKind::CALL: {
+            shared_ptr<ExpressionCall> expressionCall = dynamic_pointer_cast<ExpressionCall>(expression);
+            // members are resolved through the type of the parent
+            if (!isMember) {
+                string name = expressionCall->getName();
+                if (names.externStatementsMap.contains(name))
+                    names.referencedExternNames.insert(name);
+                else if (!names.functionNames.contains(name))
+                    return false;
+            }
+            for (shared_ptr<Expression> &argumentExpression : expressionCall->getArgumentExpressions()) {
+                if (!isInlinable(argumentExpression, names, false))
+                    return false;
+            }
+            return true;
+        }
+        case ExpressionKind::CAST: {
+            return isInlinable(expression->getValueType(), names);
+        }
+        case ExpressionKind::CHAINED: {
+            vector<shared_ptr<Expression>> chainExpressions = dynamic_pointer_cast<ExpressionChained>(expression)->getChainExpressions();
+            for (int i=0; i<chainExpressions.size(); i++) {
+                if (!isInlinable(chainExpressions.at(i), names, i > 0))
+                    return false;
+            }
+            return true;
+        }
+        case ExpressionKind::COMPOSITE_LITERAL: {
+            for (shared_ptr<Expression> &elementExpression : dynamic_pointer_cast<ExpressionCompositeLiteral>(expression)->getExpressions()) {
+                if (!isInlinable(elementExpression, names, false))
+                    return false;
+            }
+            return true;
+        }
+        case ExpressionKind::GROUPING: {
+            return isInlinable(dynamic_pointer_cast<ExpressionGrouping>(expression)->getSubExpression(), names, false);
+        }
+        case ExpressionKind::IF_ELSE: {
+            shared_ptr<ExpressionIfElse> expressionIfElse = dynamic_pointer_cast<ExpressionIfElse>(expression);
+            return isInlinable(expressionIfElse->getConditionExpression(), names, false) &&
+                isInlinable(expressionIfElse->getThenExpression(), names, false) &&
+                isInlinable(expressionIfElse->getElseExpression(), names, false);
+        }
+        case ExpressionKind::LITERAL:
+        case ExpressionKind::NONE: {
+            return true;
+        }
+        case ExpressionKind::UNARY: {
+            return isInlinable(dynamic_pointer_cast<ExpressionUnary>(expression)->getSubExpression(), names, false);
+        }
+        case ExpressionKind::VALUE: {
+            shared_ptr<ExpressionValue> expressionValue = dynamic_pointer_cast<ExpressionValue>(expression);
+            string identifier = expressionValue->getIdentifier();
+            bool isKnown = names.localNames.contains(identifier) || names.variableNames.contains(identifier) || names.functionNames.contains(identifier);
+            if (!isMember && !isKnown)
+                return false;
+            return isInlinable(expressionValue->getIndexExpression(), names, false);
+        }
+        default:
+            return false;
+    }
+}
+
+bool ModulesStore::isInlinable(shared_ptr<ValueType> valueType, InlineNames &names) {
+    if (valueType == nullptr)
+        return true;
+
+    switch (valueType->getKind()) {
+        case ValueTypeKind::BLOB:
+            return !valueType->getNamedTypeValues() && names.typeNames.contains(*valueType->getBlobName());
+        case ValueTypeKind::PROTO:
+            return names.typeNames.contains(*valueType->getProtoName());
+        case ValueTypeKind::DATA:
+            return isInlinable(valueType->getSubType(), names) && isInlinable(valueType->getCountExpression(), names, false);
+        case ValueTypeKind::PTR:
+            return isInlinable(valueType->getSubType(), names);
+        case ValueTypeKind::FUN: {
+            for (shared_ptr<ValueType> &argumentType : *valueType->getArgumentTypes()) {
+                if (!isInlinable(argumentType, names))
+                    return false;
+            }
+            return isInlinable(valueType->getReturnType(), names);
+        }
+        case ValueTypeKind::COMPOSITE: {
+            for (shared_ptr<ValueType> &elementType : *valueType->getCompositeElementTypes()) {
+                if (!isInlinable(elementType, names))
+                    return false;
+            }
+            return true;
+        }
+        case ValueTypeKind::BOXED:
+        case ValueTypeKind::NAMED_TYPE:
+            return false;
+        default:
+            return true;
+    }
+}
+
 /// Public ///
 
 void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
@@ -116,6 +390,9 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
                     for (shared_ptr<StatementVariable> statementVariable : statementBlob->getVariableStatements()) {
                         shared_ptr<StatementVariable> exportedVariableStatement = make_shared<StatementVariable>(
                             statementVariable->getShouldExport(),
+                            statementVariable->getIsConstant(),
+                            statementVariable->getIsUninitialized(),
+                            statementVariable->getAlignment(),
                             statementVariable->getIdentifier(),
                             typeForExportedStatementFromType(statementVariable->getValueType(), moduleName),
                             statementVariable->getExpression(),
@@ -144,8 +421,14 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
                 for (shared_ptr<StatementFunction> statementBlobFunction : statementBlob->getFunctionStatements()) {
                     shared_ptr<StatementFunctionDeclaration> statementBlobFunctionDeclaration = make_shared<StatementFunctionDeclaration>(
                         statementBlob->getShouldExport(),
+                        statementBlobFunction->getShouldInline(),
+                        statementBlobFunction->getIsNoInline(),
+                        statementBlobFunction->getIsHot(),
+                        statementBlobFunction->getIsCold(),
+                        statementBlobFunction->getIsPure(),
                         statementBlobFunction->getName(),
                         statementBlobFunction->getArguments(),
+                        statementBlobFunction->getNoAliasArgumentNames(),
                         statementBlobFunction->getReturnValueType(),
                         statementBlobFunction->getLocation()
                     );
@@ -156,15 +439,21 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
                         // update argument types for exported statement
                         vector<pair<string, shared_ptr<ValueType>>> exportedArguments;
                         for (pair<string, shared_ptr<ValueType>> argument : statementBlobFunctionDeclaration->getArguments())
-                            exportedArguments.push_back(pair(argument.first, typeForExportedStatementFromType(argument.second, moduleName)));
+                            exportedArguments.push_back(pair(argument.first, typeForExportedArgumentFromType(argument.second, moduleName)));
 
                         // updated return type for exported statement
                         shared_ptr<ValueType> exportedReturnValueType = typeForExportedStatementFromType(statementBlobFunctionDeclaration->getReturnValueType(), moduleName);
 
                         shared_ptr<StatementFunctionDeclaration> exportedStatementBlobFunctionDeclaration = make_shared<StatementFunctionDeclaration>(  
                             statementBlobFunctionDeclaration->getShouldExport(),
+                            statementBlobFunctionDeclaration->getShouldInline(),
+                            statementBlobFunctionDeclaration->getIsNoInline(),
+                            statementBlobFunctionDeclaration->getIsHot(),
+                            statementBlobFunctionDeclaration->getIsCold(),
+                            statementBlobFunctionDeclaration->getIsPure(),
                             statementBlobFunctionDeclaration->getName(),
                             exportedArguments,
+                            statementBlobFunctionDeclaration->getNoAliasArgumentNames(),
                             exportedReturnValueType,
                             statementBlobFunctionDeclaration->getLocation()
                         );
@@ -179,8 +468,14 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
                 shared_ptr<StatementFunction> statementFunction = dynamic_pointer_cast<StatementFunction>(statement);
                 shared_ptr<StatementFunctionDeclaration> statementFunctionDeclaration = make_shared<StatementFunctionDeclaration>(
                     statementFunction->getShouldExport(),
+                    statementFunction->getShouldInline(),
+                    statementFunction->getIsNoInline(),
+                    statementFunction->getIsHot(),
+                    statementFunction->getIsCold(),
+                    statementFunction->getIsPure(),
                     statementFunction->getName(),
                     statementFunction->getArguments(),
+                    statementFunction->getNoAliasArgumentNames(),
                     statementFunction->getReturnValueType(),
                     statementFunction->getLocation()
                 );
@@ -194,15 +489,21 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
                     // update argument types for exported statement
                     vector<pair<string, shared_ptr<ValueType>>> exportedArguments;
                     for (pair<string, shared_ptr<ValueType>> argument : statementFunctionDeclaration->getArguments())
-                        exportedArguments.push_back(pair(argument.first, typeForExportedStatementFromType(argument.second, moduleName)));
+                        exportedArguments.push_back(pair(argument.first, typeForExportedArgumentFromType(argument.second, moduleName)));
 
                     // updated return type for exported statement
                     shared_ptr<ValueType> exportedReturnValueType = typeForExportedStatementFromType(statementFunctionDeclaration->getReturnValueType(), moduleName);
 
                     shared_ptr<StatementFunctionDeclaration> exportedStatementFunctionDeclaration = make_shared<StatementFunctionDeclaration>(
                         statementFunctionDeclaration->getShouldExport(),
+                        statementFunctionDeclaration->getShouldInline(),
+                        statementFunctionDeclaration->getIsNoInline(),
+                        statementFunctionDeclaration->getIsHot(),
+                        statementFunctionDeclaration->getIsCold(),
+                        statementFunctionDeclaration->getIsPure(),
                         statementFunctionDeclaration->getName(),
                         exportedArguments,
+                        statementFunctionDeclaration->getNoAliasArgumentNames(),
                         exportedReturnValueType,
                         statementFunctionDeclaration->getLocation()
                     );
@@ -245,6 +546,9 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
                     for (shared_ptr<StatementVariable> statementVariable : statementProto->getVariableStatements()) {
                         shared_ptr<StatementVariable> exportedVariableStatement = make_shared<StatementVariable>(
                             statementVariable->getShouldExport(),
+                            statementVariable->getIsConstant(),
+                            statementVariable->getIsUninitialized(),
+                            statementVariable->getAlignment(),
                             statementVariable->getIdentifier(),
                             typeForExportedStatementFromType(statementVariable->getValueType(), moduleName),
                             statementVariable->getExpression(),
@@ -265,8 +569,14 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
 
                         shared_ptr<StatementFunctionDeclaration> exportedFunctionDeclarationStatement = make_shared<StatementFunctionDeclaration>(
                             statementFunctionDeclaration->getShouldExport(),
+                            statementFunctionDeclaration->getShouldInline(),
+                            statementFunctionDeclaration->getIsNoInline(),
+                            statementFunctionDeclaration->getIsHot(),
+                            statementFunctionDeclaration->getIsCold(),
+                            statementFunctionDeclaration->getIsPure(),
                             statementFunctionDeclaration->getName(),
                             exportedArguments,
+                            statementFunctionDeclaration->getNoAliasArgumentNames(),
                             typeForExportedStatementFromType(statementFunctionDeclaration->getReturnValueType(), moduleName),
                             statementFunctionDeclaration->getLocation()
                         );
@@ -301,8 +611,10 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
                 shared_ptr<StatementVariable> statementVariable = dynamic_pointer_cast<StatementVariable>(statement);
                 shared_ptr<StatementVariableDeclaration> statementVariableDeclaration = make_shared<StatementVariableDeclaration>(
                     statementVariable->getShouldExport(),
+                    statementVariable->getIsConstant(),
                     statementVariable->getIdentifier(),
                     statementVariable->getValueType(),
+                    nullptr,
                     statementVariable->getLocation()
                 );
 
@@ -314,11 +626,18 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
                     // updated variable type for exported statement
                     shared_ptr<ValueType> valueType = typeForExportedStatementFromType(statementVariableDeclaration->getValueType(), moduleName);
 
+                    // value of a constant can be folded by the importers, unless it depends on types of this module
+                    shared_ptr<StatementVariable> constantStatement;
+                    if (statementVariable->getIsConstant() && isFoldable(statementVariable->getValueType()))
+                        constantStatement = statementVariable;
+
                     // new declaration with updated type
                     shared_ptr<StatementVariableDeclaration> exportedStatementVariableDeclaration = make_shared<StatementVariableDeclaration>(
                         statementVariableDeclaration->getShouldExport(),
+                        statementVariableDeclaration->getIsConstant(),
                         statementVariableDeclaration->getIdentifier(),
                         valueType,
+                        constantStatement,
                         statementVariableDeclaration->getLocation()
                     );
                     moduleExportedVariableDeclarationStatements.push_back(exportedStatementVariableDeclaration);
@@ -332,6 +651,9 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
         }
     }
 
+    // Exported headers have changed
+    exportedHeaderStatementsMap.reset();
+
     // Merge with existing data
     // create new entries
     if (find(moduleNames.begin(), moduleNames.end(), moduleName) == moduleNames.end()) {
@@ -422,10 +744,10 @@ void ModulesStore::appendStatements(vector<shared_ptr<Statement>> statements) {
 
         // exported proto declarations
         for (shared_ptr<Statement> statement : moduleExportedProtoDeclarationStatements)
-            exportedBlobDeclarationStatementsMap[moduleName].push_back(statement);
+            exportedProtoDeclarationStatementsMap[moduleName].push_back(statement);
         // exported proto definitions
         for (shared_ptr<Statement> statement : moduleExportedProtoStatements)
-            exportedBlobStatementsMap[moduleName].push_back(statement);
+            exportedProtoStatementsMap[moduleName].push_back(statement);
         // exported blob declarations
         for (shared_ptr<Statement> statement : moduleExportedBlobDeclarationStatements)
             exportedBlobDeclarationStatementsMap[moduleName].push_back(statement);
@@ -499,18 +821,25 @@ vector<shared_ptr<Module>> ModulesStore::getModules() {
 
 map<string, vector<shared_ptr<Statement>>> ModulesStore::getExportedHeaderStatementsMap() {
     // construct the exported headers map
-    // it is shared by all the modules
+    // it is shared by all the modules, so build it only once
+    if (exportedHeaderStatementsMap)
+        return *exportedHeaderStatementsMap;
 
     // order for exported header statements is:
+    // - import statements
     // - blob declarations
     // - blob definitions
     // - variable declarations
     // - function declarations
+    // - function definitions which can be inlined
     map<string, vector<shared_ptr<Statement>>> statementsMap;
     for (string &moduleName : moduleNames) {
         // first initialize it with an empty array (in case there are no exported statements)
         statementsMap[moduleName] = {};
 
+        // imports (exported statements can use their types)
+        for (shared_ptr<Statement> statement : importStatementsMap[moduleName])
+            statementsMap[moduleName].push_back(statement);
         // exported proto declarations
         for (shared_ptr<Statement> statement : exportedProtoDeclarationStatementsMap[moduleName])
             statementsMap[moduleName].push_back(statement);
@@ -532,7 +861,11 @@ map<string, vector<shared_ptr<Statement>>> ModulesStore::getExportedHeaderStatem
         // exported raw functions
         for (shared_ptr<Statement> statement : exportedRawFunctionStatementsMap[moduleName])
             statementsMap[moduleName].push_back(statement);
+        // exported function definitions (with foreign functions they use)
+        for (shared_ptr<Statement> statement : exportedInlineStatements(moduleName))
+            statementsMap[moduleName].push_back(statement);
     }
 
+    exportedHeaderStatementsMap = statementsMap;
     return statementsMap;
 }
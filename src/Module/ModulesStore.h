@@ -4,15 +4,20 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
 class Module;
 class Statement;
+class Expression;
 class ValueType;
 
 using namespace std;
 
+#define MAX_INLINE_STATEMENTS_COUNT 4
+
 class ModulesStore {
 private:
     string defaultModuleName;
@@ -38,8 +43,28 @@ private:
     map<string, vector<shared_ptr<Statement>>> exportedVariableDeclarationStatementsMap;
     map<string, vector<shared_ptr<Statement>>> exportedFunctionDeclarationStatementsMap;
     map<string, vector<shared_ptr<Statement>>> exportedRawFunctionStatementsMap;
+    // cached exported headers
+    optional<map<string, vector<shared_ptr<Statement>>>> exportedHeaderStatementsMap;
+
+    // names which can be resolved by the importer when building exported function bodies
+    typedef struct {
+        set<string> typeNames;
+        set<string> variableNames;
+        set<string> functionNames;
+        map<string, shared_ptr<Statement>> externStatementsMap;
+        set<string> localNames;
+        set<string> referencedExternNames;
+        int statementsCount;
+    } InlineNames;
 
     shared_ptr<ValueType> typeForExportedStatementFromType(shared_ptr<ValueType> valueType, string moduleName);
+    shared_ptr<ValueType> typeForExportedArgumentFromType(shared_ptr<ValueType> valueType, string moduleName);
+    bool isFoldable(shared_ptr<ValueType> valueType);
+
+    vector<shared_ptr<Statement>> exportedInlineStatements(string moduleName);
+    bool isInlinable(shared_ptr<Statement> statement, InlineNames &names);
+    bool isInlinable(shared_ptr<Expression> expression, InlineNames &names, bool isMember);
+    bool isInlinable(shared_ptr<ValueType> valueType, InlineNames &names);
 
 public:
     ModulesStore(string defaultModuleName);
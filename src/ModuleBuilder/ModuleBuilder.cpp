@@ -2,7 +2,9 @@
 
 #include "Error.h"
 #include "Logger.h"
+#include "Module/BlobSpecializations.h"
 #include "Module/Module.h"
+#include "Module/ModuleReachability.h"
 #include "WrappedValue.h"
 #include "Parser/ValueType.h"
 
@@ -42,16 +44,26 @@ ModuleBuilder::ModuleBuilder(
     int pointerSize,
     llvm::Triple::ArchType archType,
     llvm::CallingConv::ID callingConvention,
+    llvm::DataLayout dataLayout,
     shared_ptr<Module> module,
-    map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap
+    map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap,
+    shared_ptr<ModuleReachability> reachability,
+    shared_ptr<BlobSpecializations> blobSpecializations,
+    bool isTbaaEnabled,
+    bool isWrapping
 ):
 defaultModuleName(defaultModuleName),
 archType(archType),
 callingConvention(callingConvention),
 module(module),
-importableHeaderStatementsMap(importableHeaderStatementsMap) {
+importableHeaderStatementsMap(importableHeaderStatementsMap),
+reachability(reachability),
+blobSpecializations(blobSpecializations),
+isWrapping(isWrapping) {
     context = make_shared<llvm::LLVMContext>();
     llvmModule = make_shared<llvm::Module>(module->getName(), *context);
+    // allocas, loads and stores get their alignment from the target's data layout
+    llvmModule->setDataLayout(dataLayout);
     builder = make_shared<llvm::IRBuilder<>>(*context);
 
     typeVoid = llvm::Type::getVoidTy(*context);
@@ -78,6 +90,13 @@ importableHeaderStatementsMap(importableHeaderStatementsMap) {
         boxedSize = intSize;
     typeBoxed = llvm::Type::getIntNTy(*context, boxedSize);
 
+    // alias analysis types, `any` is used for raw memory and can alias everything else
+    if (isTbaaEnabled) {
+        llvm::MDBuilder mdBuilder(*context);
+        tbaaRoot = mdBuilder.createTBAARoot("BRC TBAA");
+        tbaaAnyType = mdBuilder.createTBAAScalarTypeNode("any", tbaaRoot);
+    }
+
     // callback for wrapped value
     WrappedValue::setup(
         llvmModule,
@@ -92,6 +111,22 @@ importableHeaderStatementsMap(importableHeaderStatementsMap) {
 
 shared_ptr<llvm::Module> ModuleBuilder::getLlvmModule() {
     scope = make_shared<Scope>();
+    importedModuleNames.clear();
+    constantGlobalsMap.clear();
+    vtablesMap.clear();
+    funArgumentsPassedByPointerMap.clear();
+    genericBlobsMap.clear();
+    genericFunctionDeclarationsMap.clear();
+    specializedStructTypesMap.clear();
+    specializedFunctionsMap.clear();
+    importedInlineFunctions.clear();
+    tbaaStructTypesMap.clear();
+
+    // blob members may use generic blobs defined later on
+    for (shared_ptr<Statement> headerStatement : module->getHeaderStatements()) {
+        if (shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(headerStatement))
+            registerGenericBlob(module->getName(), statementBlob->getName(), statementBlob);
+    }
 
     // build header (doesn't build blob functions)
     for (shared_ptr<Statement> headerStatement : module->getHeaderStatements())
@@ -101,16 +136,38 @@ shared_ptr<llvm::Module> ModuleBuilder::getLlvmModule() {
     for (shared_ptr<Statement> headerStatement : module->getHeaderStatements()) {
         if (shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(headerStatement)) {
             for (shared_ptr<StatementFunction> statementFunction : statementBlob->getFunctionStatements()) {
-                buildStatement(statementFunction);
+                if (reachability == nullptr || reachability->isFunctionReachable(statementFunction->getName()))
+                    buildStatement(statementFunction);
             }
         }
     }
 
     // build body statements
     for (shared_ptr<Statement> statement : module->getBodyStatements()) {
+        // skip functions that are never called
+        shared_ptr<StatementFunction> statementFunction = dynamic_pointer_cast<StatementFunction>(statement);
+        if (statementFunction != nullptr && reachability != nullptr && !reachability->isFunctionReachable(statementFunction->getName()))
+            continue;
         buildStatement(statement);
     }
 
+    // build bodies of the imported functions, so they can be inlined
+    buildImportedInlineFunctions();
+
+    // build specialized blob functions, including the ones needed by other modules
+    if (blobSpecializations != nullptr) {
+        for (auto &genericBlob : genericBlobsMap) {
+            if (genericBlob.second.first.compare(module->getName()) != 0)
+                continue;
+            string qualifiedBlobName = format("{}.{}", module->getName(), genericBlob.first);
+            for (vector<shared_ptr<ValueType>> &typeArguments : blobSpecializations->getTypeArguments(qualifiedBlobName)) {
+                for (shared_ptr<StatementFunction> &statementFunction : genericBlob.second.second->getFunctionStatements())
+                    specializedFunction(genericBlob.first, typeArguments, statementFunction->getName().substr(genericBlob.first.length() + 1));
+            }
+        }
+        buildSpecializedFunctions();
+    }
+
     // verify moduleLLVM
     string errorMessage;
     llvm::raw_string_ostream llvmErrorMessage(errorMessage);
@@ -235,23 +292,39 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementFunction> statementFuncti
         return;
     }
 
+    buildFunctionBody(statementFunction, fun);
+}
+
+void ModuleBuilder::buildFunctionBody(shared_ptr<StatementFunction> statementFunction, llvm::Function *fun) {
     // define function body
     llvm::BasicBlock *block = llvm::BasicBlock::Create(*context, statementFunction->getName(), fun);
     builder->SetInsertPoint(block);
 
     scope->pushLevel();
 
-    // build arguments
+    // build arguments (result pointer goes first)
+    int argumentsOffset = fun->hasStructRetAttr() ? 1 : 0;
+    vector<bool> argumentsPassedByPointer = funArgumentsPassedByPointerMap[fun];
     for (int i=0; i<statementFunction->getArguments().size(); i++) {
         pair<string, shared_ptr<ValueType>> argument = statementFunction->getArguments().at(i);
 
-        llvm::Argument *funArgument = fun->getArg(i);
+        llvm::Argument *funArgument = fun->getArg(i + argumentsOffset);
         funArgument->setName(format("arg_{}", argument.first));
 
-        // allocate argument
         llvm::Type *funArgumentType = llvmTypeForValueType(argument.second, false);
         if (funArgumentType == nullptr)
             return;
+
+        // argument already points to memory owned by the function or to a read-only reference
+        if (i < argumentsPassedByPointer.size() && argumentsPassedByPointer.at(i)) {
+            scope->setWrappedValue(
+                argument.first,
+                WrappedValue::wrappedPointerValue(funArgument, funArgumentType, argument.second)
+            );
+            continue;
+        }
+
+        // allocate argument
         llvm::AllocaInst *alloca = builder->CreateAlloca(funArgumentType, nullptr, format("a_arg_{}", argument.first));
         builder->CreateStore(funArgument, alloca);
 
@@ -281,12 +354,21 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementFunction> statementFuncti
 }
 
 void ModuleBuilder::buildStatement(shared_ptr<StatementFunctionDeclaration> statementFunctionDeclaration) {
+    // specialized copies get declared when they are needed
+    if (blobSpecializations != nullptr)
+        genericFunctionDeclarationsMap[statementFunctionDeclaration->getName()] = statementFunctionDeclaration;
+
+    // unreachable functions are not built, so they shouldn't be declared either
+    if (reachability != nullptr && !reachability->isFunctionReachable(statementFunctionDeclaration->getName()))
+        return;
+
     buildFunctionDeclaration(
         module->getName(),
         statementFunctionDeclaration->getName(),
         statementFunctionDeclaration->getShouldExport(),
         statementFunctionDeclaration->getArguments(),
-        statementFunctionDeclaration->getReturnValueType()
+        statementFunctionDeclaration->getReturnValueType(),
+        statementFunctionDeclaration
     );
 }
 
@@ -310,13 +392,42 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementMetaExternVariable> state
 }
 
 void ModuleBuilder::buildStatement(shared_ptr<StatementMetaImport> statementMetaImport) {
+    // declarations for the module are already in place
+    if (importedModuleNames.contains(statementMetaImport->getName()))
+        return;
+
     auto it = importableHeaderStatementsMap.find(statementMetaImport->getName());
     if (it == importableHeaderStatementsMap.end()) {
         markErrorInvalidImport(statementMetaImport->getLocation(), statementMetaImport->getName());
         return;
     }
+    importedModuleNames.insert(statementMetaImport->getName());
+
+    // functions of proto conforming blobs can be called indirectly, so they are always needed
+    set<string> protoBlobNames;
+    for (shared_ptr<Statement> &importedStatement : it->second) {
+        shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(importedStatement);
+        if (statementBlob != nullptr && !statementBlob->getProtoNames().empty())
+            protoBlobNames.insert(statementBlob->getName());
+        // blob members may use generic blobs defined later on
+        if (statementBlob != nullptr)
+            registerGenericBlob(statementMetaImport->getName(), format("{}.{}", statementMetaImport->getName(), statementBlob->getName()), statementBlob);
+    }
 
     for (shared_ptr<Statement> &importedStatement : it->second) {
+        // skip functions which are not used in this module
+        if (reachability != nullptr) {
+            string functionName;
+            if (shared_ptr<StatementFunctionDeclaration> statementDeclaration = dynamic_pointer_cast<StatementFunctionDeclaration>(importedStatement))
+                functionName = statementDeclaration->getName();
+            else if (shared_ptr<StatementRawFunction> statementRawFunction = dynamic_pointer_cast<StatementRawFunction>(importedStatement))
+                functionName = statementRawFunction->getName();
+
+            bool isProtoBlobFunction = protoBlobNames.contains(functionName.substr(0, functionName.find('.')));
+            if (!functionName.empty() && !isProtoBlobFunction && !reachability->isImportedSymbolReferenced(statementMetaImport->getName(), functionName))
+                continue;
+        }
+
         switch (importedStatement->getKind()) {
             case StatementKind::BLOB: {
                 shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(importedStatement);
@@ -337,15 +448,35 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementMetaImport> statementMeta
             }
             case StatementKind::FUNCTION_DECLARATION: {
                 shared_ptr<StatementFunctionDeclaration> statementDeclaration = dynamic_pointer_cast<StatementFunctionDeclaration>(importedStatement);
+                if (blobSpecializations != nullptr)
+                    genericFunctionDeclarationsMap[format("{}.{}", statementMetaImport->getName(), statementDeclaration->getName())] = statementDeclaration;
                 buildFunctionDeclaration(
                     statementMetaImport->getName(),
                     statementDeclaration->getName(),
                     true,
                     statementDeclaration->getArguments(),
-                    statementDeclaration->getReturnValueType()
+                    statementDeclaration->getReturnValueType(),
+                    statementDeclaration
                 );
                 break;
             }
+            case StatementKind::FUNCTION: {
+                // body is built once everything else is in place
+                shared_ptr<StatementFunction> statementFunction = dynamic_pointer_cast<StatementFunction>(importedStatement);
+                llvm::Function *fun = scope->getFunction(format("{}.{}", statementMetaImport->getName(), statementFunction->getName()));
+                if (fun != nullptr)
+                    importedInlineFunctions.push_back(tuple(statementMetaImport->getName(), statementFunction, fun));
+                break;
+            }
+            case StatementKind::META_EXTERN_FUNCTION: {
+                // declared only if used by the imported bodies
+                break;
+            }
+            case StatementKind::META_IMPORT: {
+                // types used by the imported statements
+                buildStatement(dynamic_pointer_cast<StatementMetaImport>(importedStatement));
+                break;
+            }
             case StatementKind::PROTO: {
                 shared_ptr<StatementProto> statementProto = dynamic_pointer_cast<StatementProto>(importedStatement);
                 buildProtoDefinition(statementMetaImport->getName(), statementProto);
@@ -367,7 +498,9 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementMetaImport> statementMeta
                     statementMetaImport->getName(),
                     statementDeclaration->getIdentifier(),
                     true,
-                    statementDeclaration->getValueType()
+                    statementDeclaration->getValueType(),
+                    statementDeclaration->getIsConstant(),
+                    statementDeclaration->getConstantStatement()
                 );
                 break;
             }
@@ -414,7 +547,7 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementRepeat> statementRepeat)
     builder->SetInsertPoint(preBlock);
     if (preExpression != nullptr) {
         llvm::Value *preConditionValue = wrappedValueForExpression(preExpression)->getValue();
-        builder->CreateCondBr(preConditionValue, bodyBlock, afterBlock);
+        builder->CreateCondBr(preConditionValue, bodyBlock, afterBlock, branchWeightsForLikelihood(statementRepeat->getIsConditionLikely()));
     } else {
         builder->CreateBr(bodyBlock);
     }
@@ -426,30 +559,70 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementRepeat> statementRepeat)
     // Store the current stack location, stack shouldn't change accross the runs, for example because of allocas
     llvm::Type *ptrType = llvm::PointerType::get(*context, 0);
     llvm::Function *stackSaveIntrinscic = llvm::Intrinsic::getOrInsertDeclaration(llvmModule.get(), llvm::Intrinsic::stacksave, {ptrType});
-    llvm::Value *stackValue = builder->CreateCall(stackSaveIntrinscic, {}, "stack");
+    llvm::CallInst *stackValue = builder->CreateCall(stackSaveIntrinscic, {}, "stack");
 
+    // body has its own scope, so its locals can end with each iteration
+    scope->pushLevel();
     buildStatement(bodyStatement);
+    buildLifetimesEnd();
+    scope->popLevel();
+
+    // memory accesses of the body are independent between the runs
+    llvm::MDNode *accessGroup = nullptr;
+    if (statementRepeat->getIsParallel()) {
+        accessGroup = llvm::MDNode::getDistinct(*context, {});
+        for (auto it = bodyBlock->getIterator(); it != fun->end(); it++) {
+            for (llvm::Instruction &instruction : *it) {
+                if (llvm::isa<llvm::LoadInst>(instruction) || llvm::isa<llvm::StoreInst>(instruction))
+                    instruction.setMetadata(llvm::LLVMContext::MD_access_group, llvm::uniteAccessGroups(instruction.getMetadata(llvm::LLVMContext::MD_access_group), accessGroup));
+            }
+        }
+    }
 
-    // Restore stack to expected location
-    llvm::Function *stackRestoreIntrinscic = llvm::Intrinsic::getOrInsertDeclaration(llvmModule.get(), llvm::Intrinsic::stackrestore, {ptrType});
-    builder->CreateCall(stackRestoreIntrinscic, llvm::ArrayRef({stackValue}));
+    // Restore stack to expected location, nothing to restore if the body didn't allocate anything
+    bool hasBodyAllocas = false;
+    for (auto it = bodyBlock->getIterator(); it != fun->end() && !hasBodyAllocas; it++) {
+        for (llvm::Instruction &instruction : *it) {
+            if (llvm::isa<llvm::AllocaInst>(instruction)) {
+                hasBodyAllocas = true;
+                break;
+            }
+        }
+    }
+    if (hasBodyAllocas) {
+        llvm::Function *stackRestoreIntrinscic = llvm::Intrinsic::getOrInsertDeclaration(llvmModule.get(), llvm::Intrinsic::stackrestore, {ptrType});
+        builder->CreateCall(stackRestoreIntrinscic, llvm::ArrayRef<llvm::Value *>({stackValue}));
+    } else {
+        stackValue->eraseFromParent();
+    }
 
     // post statement
     if (postStatement != nullptr)
         buildStatement(postStatement);
 
     // post condition
+    llvm::BranchInst *latchBranch;
     if (postExpression != nullptr) {
         llvm::Value *postConditionValue = wrappedValueForExpression(postExpression)->getValue();
-        builder->CreateCondBr(postConditionValue, preBlock, afterBlock);
+        latchBranch = builder->CreateCondBr(postConditionValue, preBlock, afterBlock, branchWeightsForLikelihood(statementRepeat->getIsConditionLikely()));
+    } else if (isCountedLoop(statementRepeat)) {
+        // counted loops are rotated, the pre condition only guards the first run
+        // and is checked again at the bottom, so the loop has a single latch with a known exit
+        llvm::Value *latchConditionValue = wrappedValueForExpression(preExpression)->getValue();
+        latchBranch = builder->CreateCondBr(latchConditionValue, bodyBlock, afterBlock, branchWeightsForLikelihood(statementRepeat->getIsConditionLikely()));
     } else {
-        builder->CreateBr(preBlock);
+        latchBranch = builder->CreateBr(preBlock);
     }
 
+    // optimization hints are attached to the jump back
+    if (llvm::MDNode *loopMetadata = loopMetadataForStatementRepeat(statementRepeat, accessGroup))
+        latchBranch->setMetadata(llvm::LLVMContext::MD_loop, loopMetadata);
+
     // loop post
     fun->insert(fun->end(), afterBlock);
     builder->SetInsertPoint(afterBlock);
 
+    buildLifetimesEnd();
     scope->popLevel();
 }
 
@@ -460,7 +633,16 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementReturn> statementReturn)
         shared_ptr<WrappedValue> returnWrappedValue = wrappedValueForExpression(statementReturn->getExpression());
         if (returnWrappedValue == nullptr)
             return;
-        builder->CreateRet(returnWrappedValue->getValue());
+
+        // large results are copied into memory provided by the caller
+        llvm::Function *fun = basicBlock->getParent();
+        if (fun->hasStructRetAttr()) {
+            llvm::Type *resultType = fun->getParamStructRetType(0);
+            builder->CreateMemCpy(fun->getArg(0), alignForType(resultType), returnWrappedValue->getPointerValue(), alignForType(resultType), sizeInBytesForType(resultType));
+            builder->CreateRetVoid();
+        } else {
+            builder->CreateRet(returnWrappedValue->getValue());
+        }
     } else {
         builder->CreateRetVoid();
     }
@@ -484,11 +666,12 @@ void ModuleBuilder::buildStatement(shared_ptr<StatementVariableDeclaration> stat
         module->getName(),
         statementVariableDeclaration->getIdentifier(),
         statementVariableDeclaration->getShouldExport(),
-        statementVariableDeclaration->getValueType()
+        statementVariableDeclaration->getValueType(),
+        statementVariableDeclaration->getIsConstant()
     );
 }
 
-void ModuleBuilder::buildFunctionDeclaration(string moduleName, string name, bool isExtern, vector<pair<string, shared_ptr<ValueType>>> arguments, shared_ptr<ValueType> returnType) {    
+void ModuleBuilder::buildFunctionDeclaration(string moduleName, string name, bool isExtern, vector<pair<string, shared_ptr<ValueType>>> arguments, shared_ptr<ValueType> returnType, shared_ptr<StatementFunctionDeclaration> attributesStatement) {    
     // symbol name
     string symbolName = name;
     if (!moduleName.empty() && moduleName.compare(defaultModuleName) != 0)
@@ -500,17 +683,14 @@ void ModuleBuilder::buildFunctionDeclaration(string moduleName, string name, boo
         internalName = symbolName;
 
     // arguments
-    vector<llvm::Type *> funArgTypes;
-    for (pair<string, shared_ptr<ValueType>> &argument : arguments) {
-        llvm::Type *funArgType = llvmTypeForValueType(argument.second);
-        if (funArgType == nullptr)
-            return;
-        funArgTypes.push_back(funArgType);
-    }
-
-    // return type
-    llvm::Type *funReturnType = llvmTypeForValueType(returnType);
-    if (funReturnType == nullptr)
+    vector<shared_ptr<ValueType>> argumentTypes;
+    for (pair<string, shared_ptr<ValueType>> &argument : arguments)
+        argumentTypes.push_back(argument.second);
+
+    // foreign functions keep their declared signature
+    bool isForeign = moduleName.empty();
+    llvm::FunctionType *funType = funTypeForSignature(argumentTypes, returnType, isForeign);
+    if (funType == nullptr)
         return;
     
     // linkage
@@ -519,13 +699,66 @@ void ModuleBuilder::buildFunctionDeclaration(string moduleName, string name, boo
         funLinkage = llvm::GlobalValue::ExternalLinkage;
 
     // build function declaration
-    llvm::FunctionType *funType = llvm::FunctionType::get(funReturnType, funArgTypes, false);
     llvm::Function *fun = llvm::Function::Create(funType, funLinkage, symbolName, *llvmModule);
     fun->setCallingConv(callingConvention);
+    if (!isForeign)
+        fun->setAttributes(funAttributesForSignature(argumentTypes, returnType));
+    funArgumentsPassedByPointerMap[fun] = argumentsPassedByPointerForSignature(argumentTypes, isForeign);
+    if (!isForeign && attributesStatement != nullptr)
+        buildFunctionAttributes(fun, attributesStatement);
 
     scope->setFunction(internalName, fun);
 }
 
+void ModuleBuilder::buildFunctionAttributes(llvm::Function *fun, shared_ptr<StatementFunctionDeclaration> attributesStatement) {
+    if (attributesStatement->getShouldInline())
+        fun->addFnAttr(llvm::Attribute::AlwaysInline);
+    if (attributesStatement->getIsNoInline())
+        fun->addFnAttr(llvm::Attribute::NoInline);
+    if (attributesStatement->getIsHot())
+        fun->addFnAttr(llvm::Attribute::Hot);
+
+    // rarely run, so it's kept small and branches leading to its calls are treated as unlikely
+    if (attributesStatement->getIsCold()) {
+        fun->addFnAttr(llvm::Attribute::Cold);
+        fun->addFnAttr(llvm::Attribute::OptimizeForSize);
+    }
+
+    // result pointer goes first
+    int argumentsOffset = fun->hasStructRetAttr() ? 1 : 0;
+    bool isPure = attributesStatement->getIsPure();
+    // pure function can only capture its pointers by returning them
+    bool isCapturingPointers = isPointerContainedInType(fun->getReturnType());
+    bool isReadingMemory = false;
+
+    vector<pair<string, shared_ptr<ValueType>>> arguments = attributesStatement->getArguments();
+    for (int i=0; i<arguments.size() && i + argumentsOffset < fun->arg_size(); i++) {
+        int argumentIndex = i + argumentsOffset;
+        llvm::Type *funArgumentType = fun->getArg(argumentIndex)->getType();
+        isReadingMemory = isReadingMemory || isPointerContainedInType(funArgumentType);
+
+        if (attributesStatement->getNoAliasArgumentNames().contains(arguments.at(i).first))
+            fun->addParamAttr(argumentIndex, llvm::Attribute::NoAlias);
+
+        // pure functions don't write through any of their pointers, references included
+        if (isPure && funArgumentType->isPointerTy() && !fun->hasParamAttribute(argumentIndex, llvm::Attribute::ByVal))
+            fun->addParamAttr(argumentIndex, llvm::Attribute::ReadOnly);
+        if (isPure && !isCapturingPointers && funArgumentType->isPointerTy())
+            fun->addParamAttr(argumentIndex, llvm::Attribute::getWithCaptureInfo(*context, llvm::CaptureInfo::none()));
+    }
+
+    // no side effects, so calls with unused results can be removed and repeated calls merged
+    if (isPure) {
+        llvm::MemoryEffects memoryEffects = isReadingMemory ? llvm::MemoryEffects::readOnly() : llvm::MemoryEffects::none();
+        // but large results are still written to the caller's memory
+        if (fun->hasStructRetAttr())
+            memoryEffects |= llvm::MemoryEffects::argMemOnly(llvm::ModRefInfo::ModRef);
+        fun->setMemoryEffects(memoryEffects);
+        fun->setWillReturn();
+        fun->setDoesNotThrow();
+    }
+}
+
 void ModuleBuilder::buildRawFunction(string moduleName, shared_ptr<StatementRawFunction> statement) {
     // symbol name
     string symbolName = statement->getName();
@@ -584,7 +817,7 @@ void ModuleBuilder::buildRawFunction(string moduleName, shared_ptr<StatementRawF
     scope->setInlineAsm(internalName, rawFun);
 }
 
-void ModuleBuilder::buildVariableDeclaration(string moduleName, string name, bool isExtern, shared_ptr<ValueType> valueType) {
+void ModuleBuilder::buildVariableDeclaration(string moduleName, string name, bool isExtern, shared_ptr<ValueType> valueType, bool isConstant, shared_ptr<StatementVariable> constantStatement) {
     // symbol name
     string symbolName = name;
     if (!moduleName.empty() && moduleName.compare(defaultModuleName) != 0)
@@ -605,7 +838,24 @@ void ModuleBuilder::buildVariableDeclaration(string moduleName, string name, boo
         linkage = llvm::GlobalValue::LinkageTypes::ExternalLinkage :
         llvm::GlobalValue::LinkageTypes::InternalLinkage;
 
-    llvm::GlobalVariable *global = new llvm::GlobalVariable(*llvmModule, type, false, linkage, nullptr, symbolName);
+    // value of an imported constant is available, so it can be folded instead of loaded
+    llvm::Constant *constantValue = nullptr;
+    if (constantStatement != nullptr) {
+        constantValue = llvm::Constant::getNullValue(type);
+        if (constantStatement->getExpression() != nullptr) {
+            shared_ptr<WrappedValue> wrappedValue = wrappedValueForExpression(constantStatement->getExpression());
+            constantValue = wrappedValue != nullptr ? wrappedValue->getConstantValue() : nullptr;
+        }
+        if (constantValue != nullptr && constantValue->getType() != type)
+            constantValue = nullptr;
+    }
+    // the exporting module still provides the symbol
+    if (constantValue != nullptr)
+        linkage = llvm::GlobalValue::LinkageTypes::AvailableExternallyLinkage;
+
+    llvm::GlobalVariable *global = new llvm::GlobalVariable(*llvmModule, type, isConstant, linkage, constantValue, symbolName);
+    if (constantValue != nullptr)
+        global->setAlignment(llvmModule->getDataLayout().getPreferredAlign(global));
 
     // register
     scope->setWrappedValue(
@@ -646,34 +896,27 @@ void ModuleBuilder::buildProtoDefinition(string moduleName, shared_ptr<Statement
         return;
     }
 
-    // Generate types for body (and convert them to pointers) and keep each member type
+    // Keep each member type (as a pointer), the members themselves are in the vtable
     vector<pair<string, shared_ptr<ValueType>>> members;
-    vector<llvm::Type *> types;
-
-    // first add pointer to the implementation
-    types.push_back(typePtr);
 
-    // then pointers to all the variables
+    // first the variables
     for (shared_ptr<StatementVariable> statementVariable : statement->getVariableStatements()) {
         shared_ptr<ValueType> valueType = ValueType::ptr(statementVariable->getValueType());
         members.push_back(pair(statementVariable->getIdentifier(), valueType));
-        llvm::Type *type = llvmTypeForValueType(valueType);
-        if (type == nullptr)
+        if (llvmTypeForValueType(valueType) == nullptr)
             return;
-        types.push_back(type);
     }
 
-    // and then pointers to the functions
+    // and then the functions
     for (shared_ptr<StatementFunctionDeclaration> statementFunctionDeclaration : statement->getFunctionDeclarationStatements()) {
         shared_ptr<ValueType> valueType = ValueType::ptr(statementFunctionDeclaration->getValueType());
         members.push_back(pair(statementFunctionDeclaration->getName(), valueType));
-        llvm::Type *type = llvmTypeForValueType(valueType);
-        if (type == nullptr)
+        if (llvmTypeForValueType(valueType) == nullptr)
             return;
-        types.push_back(type);
     }
 
-    structType->setBody(types, false);
+    // proto value is a pointer to the implementing blob and a pointer to the vtable shared by all of its instances
+    structType->setBody({typePtr, typePtr}, false);
     scope->setProtoStructType(internalName, structType, members);
 }
 
@@ -723,11 +966,120 @@ void ModuleBuilder::buildBlobDefinition(string moduleName, string name, vector<p
     scope->setStruct(internalName, structType, memberNames);
 }
 
+void ModuleBuilder::buildSpecializedFunctions() {
+    // building a function can request further specializations
+    while (!pendingSpecializedFunctions.empty()) {
+        auto [statementFunction, fun, blobName, typeArguments] = pendingSpecializedFunctions.back();
+        pendingSpecializedFunctions.pop_back();
+
+        setNamedTypes(blobName, typeArguments);
+        buildFunctionBody(statementFunction, fun);
+    }
+
+    namedTypesBlobName.clear();
+    namedTypesMap.clear();
+}
+
+void ModuleBuilder::buildImportedInlineFunctions() {
+    // bodies can use symbols which are not used by this module
+    set<string> moduleNames;
+    for (auto &importedInlineFunction : importedInlineFunctions)
+        moduleNames.insert(get<0>(importedInlineFunction));
+
+    for (const string &moduleName : moduleNames) {
+        for (shared_ptr<Statement> &importedStatement : importableHeaderStatementsMap[moduleName]) {
+            if (shared_ptr<StatementFunctionDeclaration> statementDeclaration = dynamic_pointer_cast<StatementFunctionDeclaration>(importedStatement)) {
+                if (scope->getFunction(format("{}.{}", moduleName, statementDeclaration->getName())) == nullptr) {
+                    buildFunctionDeclaration(
+                        moduleName,
+                        statementDeclaration->getName(),
+                        true,
+                        statementDeclaration->getArguments(),
+                        statementDeclaration->getReturnValueType(),
+                        statementDeclaration
+                    );
+                }
+            } else if (shared_ptr<StatementMetaExternFunction> statementMetaExternFunction = dynamic_pointer_cast<StatementMetaExternFunction>(importedStatement)) {
+                if (llvmModule->getFunction(statementMetaExternFunction->getName()) == nullptr) {
+                    buildFunctionDeclaration(
+                        "",
+                        statementMetaExternFunction->getName(),
+                        true,
+                        statementMetaExternFunction->getArguments(),
+                        statementMetaExternFunction->getReturnValueType()
+                    );
+                }
+            }
+        }
+    }
+
+    for (auto &[moduleName, statementFunction, fun] : importedInlineFunctions) {
+        // body refers to the symbols by their names in the exporting module
+        scope->pushLevel();
+        setImportedAliases(moduleName);
+        buildFunctionBody(statementFunction, fun);
+        scope->popLevel();
+
+        // exporting module still provides the symbol, so the body is only used for optimizations
+        fun->setLinkage(llvm::GlobalValue::LinkageTypes::AvailableExternallyLinkage);
+    }
+    importedInlineFunctions.clear();
+}
+
+void ModuleBuilder::setImportedAliases(string moduleName) {
+    for (shared_ptr<Statement> &importedStatement : importableHeaderStatementsMap[moduleName]) {
+        switch (importedStatement->getKind()) {
+            case StatementKind::BLOB: {
+                shared_ptr<StatementBlob> statementBlob = dynamic_pointer_cast<StatementBlob>(importedStatement);
+                llvm::StructType *structType = scope->getStructType(format("{}.{}", moduleName, statementBlob->getName()));
+                if (structType == nullptr)
+                    break;
+                vector<string> memberNames;
+                for (pair<string, shared_ptr<ValueType>> &member : statementBlob->getMembers())
+                    memberNames.push_back(member.first);
+                scope->setStruct(statementBlob->getName(), structType, memberNames);
+                break;
+            }
+            case StatementKind::FUNCTION_DECLARATION: {
+                shared_ptr<StatementFunctionDeclaration> statementDeclaration = dynamic_pointer_cast<StatementFunctionDeclaration>(importedStatement);
+                scope->setFunction(statementDeclaration->getName(), scope->getFunction(format("{}.{}", moduleName, statementDeclaration->getName())));
+                break;
+            }
+            case StatementKind::META_EXTERN_FUNCTION: {
+                shared_ptr<StatementMetaExternFunction> statementMetaExternFunction = dynamic_pointer_cast<StatementMetaExternFunction>(importedStatement);
+                scope->setFunction(statementMetaExternFunction->getName(), llvmModule->getFunction(statementMetaExternFunction->getName()));
+                break;
+            }
+            case StatementKind::PROTO: {
+                shared_ptr<StatementProto> statementProto = dynamic_pointer_cast<StatementProto>(importedStatement);
+                string protoName = format("{}.{}", moduleName, statementProto->getName());
+                llvm::StructType *protoStructType = scope->getProtoStructType(protoName);
+                optional<vector<pair<string, shared_ptr<ValueType>>>> members = scope->getProtoStructMembers(protoName);
+                if (protoStructType != nullptr && members)
+                    scope->setProtoStructType(statementProto->getName(), protoStructType, *members);
+                break;
+            }
+            case StatementKind::VARIABLE_DECLARATION: {
+                shared_ptr<StatementVariableDeclaration> statementDeclaration = dynamic_pointer_cast<StatementVariableDeclaration>(importedStatement);
+                shared_ptr<WrappedValue> wrappedValue = scope->getWrappedValue(format("{}.{}", moduleName, statementDeclaration->getIdentifier()));
+                if (wrappedValue != nullptr)
+                    scope->setWrappedValue(statementDeclaration->getIdentifier(), wrappedValue);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
 void ModuleBuilder::buildLocalVariable(shared_ptr<StatementVariable> statement) {
     llvm::Type *type = llvmTypeForValueType(statement->getValueType(), false);
     if (type == nullptr)
         return;
-    llvm::AllocaInst *alloca = builder->CreateAlloca(type, nullptr, format("a_{}", statement->getIdentifier()));
+    llvm::AllocaInst *alloca = buildLocalAlloca(type, format("a_{}", statement->getIdentifier()));
+    // alignment is only ever increased
+    if (optional<int> alignment = statement->getAlignment())
+        alloca->setAlignment(max(alloca->getAlign(), llvm::Align(*alignment)));
 
     shared_ptr<WrappedValue> wrappedValue = WrappedValue::wrappedValue(alloca, statement->getValueType());
 
@@ -738,7 +1090,12 @@ void ModuleBuilder::buildLocalVariable(shared_ptr<StatementVariable> statement)
     );
 
     if (shared_ptr<Expression> valueExpression = statement->getExpression()) {
-        buildAssignment(wrappedValue, valueExpression);
+        buildAssignment(wrappedValue, valueExpression, true);
+    } else if (statement->getIsUninitialized()) {
+        // explicitly left as it is
+    } else if (type->isAggregateType()) {
+        // a memset can be removed by the optimizer if the value is overwritten anyway
+        builder->CreateMemSet(alloca, builder->getInt8(0), sizeInBytesForType(type), alignForType(type));
     } else {
         llvm::Constant *constantValue = llvm::Constant::getNullValue(type);
         builder->CreateStore(constantValue, alloca);
@@ -775,7 +1132,23 @@ void ModuleBuilder::buildGlobalVariable(shared_ptr<StatementVariable> statement)
         }
     }
 
-    llvm::GlobalVariable *global = new llvm::GlobalVariable(*llvmModule, type, false, linkage, constantValue, symbolName);
+    // constants which are not exported go into read-only data and share the global with the same value
+    if (statement->getIsConstant() && !statement->getShouldExport()) {
+        llvm::GlobalVariable *global = constantGlobalForConstant(constantValue);
+        if (optional<int> alignment = statement->getAlignment())
+            global->setAlignment(max(global->getAlign().valueOrOne(), llvm::Align(*alignment)));
+        scope->setWrappedValue(
+            internalName,
+            WrappedValue::wrappedValue(global, statement->getValueType())
+        );
+        return;
+    }
+
+    llvm::GlobalVariable *global = new llvm::GlobalVariable(*llvmModule, type, statement->getIsConstant(), linkage, constantValue, symbolName);
+    global->setAlignment(llvmModule->getDataLayout().getPreferredAlign(global));
+    // alignment is only ever increased
+    if (optional<int> alignment = statement->getAlignment())
+        global->setAlignment(max(global->getAlign().valueOrOne(), llvm::Align(*alignment)));
 
     // register
     scope->setWrappedValue(
@@ -784,7 +1157,7 @@ void ModuleBuilder::buildGlobalVariable(shared_ptr<StatementVariable> statement)
     );
 }
 
-void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue, shared_ptr<Expression> valueExpression) {
+void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue, shared_ptr<Expression> valueExpression, bool isInitialization) {
     if (targetWrappedValue == nullptr)
         return;
 
@@ -794,6 +1167,9 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
             // data <- { }
             // copy values from literal expression into an allocated array
             case ExpressionKind::COMPOSITE_LITERAL: {
+                if (buildConstantCopy(targetWrappedValue, dynamic_pointer_cast<ExpressionCompositeLiteral>(valueExpression), isInitialization))
+                    break;
+
                 vector<shared_ptr<Expression>> valueExpressions = dynamic_pointer_cast<ExpressionCompositeLiteral>(valueExpression)->getExpressions();
                 int sourceCount = valueExpressions.size();
                 int targetCount = targetWrappedValue->getArrayType()->getNumElements();
@@ -804,11 +1180,24 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                         builder->getInt32(i)
                     };
                     llvm::Value *targetPointerValue = targetWrappedValue->getPointerValue();
-                    llvm::Value *targetPtr = builder->CreateGEP(targetWrappedValue->getType(), targetPointerValue, index, format("gep_data-{}", string(targetPointerValue->getName())));
+                    llvm::Value *targetPtr = builder->CreateInBoundsGEP(targetWrappedValue->getType(), targetPointerValue, index, format("gep_data-{}", string(targetPointerValue->getName())));
                     llvm::Value *sourceValue = wrappedValueForExpression(valueExpressions.at(i))->getValue();
                     if (sourceValue == nullptr)
                         return;
-                    builder->CreateStore(sourceValue, targetPtr);
+                    llvm::StoreInst *store = builder->CreateStore(sourceValue, targetPtr);
+                    if (llvm::MDNode *tbaaAccessTag = tbaaAccessTagForValueType(targetWrappedValue->getValueType()->getSubType()))
+                        store->setMetadata(llvm::LLVMContext::MD_tbaa, tbaaAccessTag);
+                }
+
+                // rest of a new variable is cleared, same as with a constant copy
+                if (isInitialization && count < targetCount) {
+                    llvm::Type *elementType = targetWrappedValue->getArrayType()->getElementType();
+                    llvm::Value *index[] = {
+                        builder->getInt32(0),
+                        builder->getInt32(count)
+                    };
+                    llvm::Value *clearPointerValue = builder->CreateInBoundsGEP(targetWrappedValue->getType(), targetWrappedValue->getPointerValue(), index);
+                    builder->CreateMemSet(clearPointerValue, builder->getInt8(0), sizeInBytesForType(llvm::ArrayType::get(elementType, targetCount - count)), alignForType(elementType));
                 }
                 break;
             }
@@ -817,6 +1206,8 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
             case ExpressionKind::VALUE: // data <- data
             case ExpressionKind::CHAINED: // data <- .val
             case ExpressionKind::IF_ELSE: // data <- if else
+            case ExpressionKind::BINARY: // data <- data + data
+            case ExpressionKind::GROUPING: // data <- (data + data)
             case ExpressionKind::CALL: { // data <- function()
                 shared_ptr<WrappedValue> sourceWrappedValue;
 
@@ -827,8 +1218,7 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                     shared_ptr<ExpressionCall> expressionCall = dynamic_pointer_cast<ExpressionCall>(valueExpression);
                     sourceWrappedValue = wrappedValueForExpression(expressionCall);
                 } else {
-                    shared_ptr<ExpressionChained> expressionChained = dynamic_pointer_cast<ExpressionChained>(valueExpression);
-                    sourceWrappedValue = wrappedValueForExpression(expressionChained);
+                    sourceWrappedValue = wrappedValueForExpression(valueExpression);
                 }
                 if (sourceWrappedValue == nullptr)
                     return;
@@ -842,13 +1232,13 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                 int sourceCount = sourceWrappedValue->getArrayType()->getArrayNumElements();
                 int targetCount = targetWrappedValue->getArrayType()->getNumElements();
                 int elementsCount = min(sourceCount, targetCount);
-                int elementSize = sizeInBitsForType(sourceWrappedValue->getArrayType()->getElementType()) / 8;
+                int elementSize = sizeInBytesForType(sourceWrappedValue->getArrayType()->getElementType());
 
                 builder->CreateMemCpy(
                     targetWrappedValue->getPointerValue(),
-                    llvm::MaybeAlign(1),
+                    alignForType(targetWrappedValue->getArrayType()),
                     sourceWrappedValue->getPointerValue(),
-                    llvm::MaybeAlign(1),
+                    alignForType(sourceWrappedValue->getArrayType()),
                     elementsCount * elementSize
                 );
                 break;
@@ -863,6 +1253,9 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
         switch (valueExpression->getKind()) {
             // blob <- { }
             case ExpressionKind::COMPOSITE_LITERAL: {
+                if (buildConstantCopy(targetWrappedValue, dynamic_pointer_cast<ExpressionCompositeLiteral>(valueExpression), isInitialization))
+                    break;
+
                 vector<shared_ptr<Expression>> valueExpressions = dynamic_pointer_cast<ExpressionCompositeLiteral>(valueExpression)->getExpressions();
                 int membersCount = targetWrappedValue->getStructType()->getStructNumElements();
                 for (int i=0; i<membersCount; i++) {
@@ -876,7 +1269,7 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                         return;
                     }
                     llvm::Value *targetPointerValue = targetWrappedValue->getPointerValue();
-                    llvm::Value *targetMember = builder->CreateGEP(targetWrappedValue->getType(), targetPointerValue, index, format("gep_blob-{}", string(targetPointerValue->getName())));
+                    llvm::Value *targetMember = builder->CreateInBoundsGEP(targetWrappedValue->getType(), targetPointerValue, index, format("gep_blob-{}", string(targetPointerValue->getName())));
                     builder->CreateStore(wrappedSourceValue->getValue(), targetMember);
                 }
                 break;
@@ -889,6 +1282,19 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                 shared_ptr<WrappedValue> sourceWrappedValue = wrappedValueForExpression(valueExpression);
                 if (sourceWrappedValue == nullptr)
                     return;
+
+                // large blobs in memory are copied directly, instead of going through a first-class aggregate
+                bool isInMemory = valueExpression->getKind() == ExpressionKind::VALUE || valueExpression->getKind() == ExpressionKind::CHAINED;
+                llvm::StructType *structType = targetWrappedValue->getStructType();
+                if (isInMemory && sizeInBytesForType(structType) >= MIN_AGGREGATE_COPY_SIZE) {
+                    llvm::Value *sourcePointerValue = sourceWrappedValue->getPointerValue();
+                    llvm::Value *targetPointerValue = targetWrappedValue->getPointerValue();
+                    if (sourcePointerValue == nullptr || targetPointerValue == nullptr)
+                        return;
+                    builder->CreateMemCpy(targetPointerValue, alignForType(structType), sourcePointerValue, alignForType(structType), sizeInBytesForType(structType));
+                    break;
+                }
+
                 llvm::Value *sourceValue = sourceWrappedValue->getValue();
                 if (sourceValue == nullptr)
                     return;
@@ -911,44 +1317,28 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                 vector<shared_ptr<Expression>> valueExpressions = dynamic_pointer_cast<ExpressionCompositeLiteral>(valueExpression)->getExpressions();
                 shared_ptr<WrappedValue> sourceWrappedValue = wrappedValueForExpression(valueExpressions.at(0));
                 string sourceBlobName = *(sourceWrappedValue->getValueType()->getSubType()->getBlobName());
-                llvm::StructType *sourceStructType = scope->getStructType(sourceBlobName);
                 llvm::Value *sourcePointerValue = sourceWrappedValue->getValue();
                 if (sourcePointerValue == nullptr)
                     return;
 
                 string targetProtoName = *(targetWrappedValue->getValueType()->getProtoName());
-                auto targetProtoMembers = *scope->getProtoStructMembers(targetProtoName);
-
-                int targetMembersCount = targetWrappedValue->getStructType()->getStructNumElements();
-                for (int i=0; i<targetMembersCount; i++) {
-                    llvm::Value *sourceValue;
-                    if (i == 0) {
-                        // first index should be pointer to the implementing blob
-                        sourceValue = sourcePointerValue;
-                    } else {
-                        pair<string, shared_ptr<ValueType>> targetMember = targetProtoMembers.at(i - 1);
-                        // if subsequent member is a function, retrieve function from the registered ones
-                        if (targetMember.second->getSubType()->isFunction()) {
-                            string sourceFunctionName = format("{}.{}", sourceBlobName, targetMember.first);
-                            sourceValue = scope->getFunction(sourceFunctionName);
-                        // otherwise figure out index and copy value from the source struct
-                        } else {
-                            int sourceMemberIndex = *scope->getStructMemberIndex(sourceBlobName, targetMember.first);
-                            llvm::Value *sourceIndex[] = {
-                                builder->getInt32(0),
-                                builder->getInt32(sourceMemberIndex)
-                            };
-                            sourceValue = builder->CreateGEP(sourceStructType, sourcePointerValue, sourceIndex);
-                        }
-                    }
+                llvm::GlobalVariable *vtable = vtableForBlobProto(sourceBlobName, targetProtoName);
+                if (vtable == nullptr)
+                    return;
 
+                // first index should be pointer to the implementing blob and second one to the vtable
+                llvm::Value *sourceValues[] = {
+                    sourcePointerValue,
+                    vtable
+                };
+                for (int i=0; i<2; i++) {
                     llvm::Value *targetIndex[] = {
                         builder->getInt32(0),
                         builder->getInt32(i)
                     };
                     llvm::StructType *targetStructType = targetWrappedValue->getStructType();
-                    llvm::Value *targetMember = builder->CreateGEP(targetStructType, targetWrappedValue->getPointerValue(), targetIndex);
-                    builder->CreateStore(sourceValue, targetMember);
+                    llvm::Value *targetMember = builder->CreateInBoundsGEP(targetStructType, targetWrappedValue->getPointerValue(), targetIndex);
+                    builder->CreateStore(sourceValues[i], targetMember);
                 }
                 break;
             }
@@ -960,6 +1350,19 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                 shared_ptr<WrappedValue> sourceWrappedValue = wrappedValueForExpression(valueExpression);
                 if (sourceWrappedValue == nullptr)
                     return;
+
+                // same as for blobs
+                bool isInMemory = valueExpression->getKind() == ExpressionKind::VALUE || valueExpression->getKind() == ExpressionKind::CHAINED;
+                llvm::StructType *structType = targetWrappedValue->getStructType();
+                if (isInMemory && sizeInBytesForType(structType) >= MIN_AGGREGATE_COPY_SIZE) {
+                    llvm::Value *sourcePointerValue = sourceWrappedValue->getPointerValue();
+                    llvm::Value *targetPointerValue = targetWrappedValue->getPointerValue();
+                    if (sourcePointerValue == nullptr || targetPointerValue == nullptr)
+                        return;
+                    builder->CreateMemCpy(targetPointerValue, alignForType(structType), sourcePointerValue, alignForType(structType), sizeInBytesForType(structType));
+                    break;
+                }
+
                 llvm::Value *sourceValue = sourceWrappedValue->getValue();
                 if (sourceValue == nullptr)
                     return;
@@ -990,7 +1393,9 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
 
                 llvm::Value *sourceValue = adrWrappedValue->getValue();
                 llvm::Value *targetValue = targetWrappedValue->getPointerValue();
-                builder->CreateStore(sourceValue, targetValue);
+                llvm::StoreInst *store = builder->CreateStore(sourceValue, targetValue, targetWrappedValue->getIsVolatile());
+                if (llvm::MDNode *tbaaAccessTag = targetWrappedValue->getTbaaAccessTag())
+                    store->setMetadata(llvm::LLVMContext::MD_tbaa, tbaaAccessTag);
                     break;
             }
             // ptr <- ?
@@ -1003,7 +1408,9 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                     markErrorInvalidAssignment(valueExpression->getLocation());
                     return;
                 }
-                builder->CreateStore(wrappedSourceValue->getValue(), targetWrappedValue->getPointerValue());
+                llvm::StoreInst *store = builder->CreateStore(wrappedSourceValue->getValue(), targetWrappedValue->getPointerValue(), targetWrappedValue->getIsVolatile());
+                if (llvm::MDNode *tbaaAccessTag = targetWrappedValue->getTbaaAccessTag())
+                    store->setMetadata(llvm::LLVMContext::MD_tbaa, tbaaAccessTag);
                 break;
             }
             default: {
@@ -1021,6 +1428,7 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
             case ExpressionKind::LITERAL: // simple <- literal
             case ExpressionKind::BINARY: // simple <- binary expression
             case ExpressionKind::UNARY: // simple <- unary expression
+            case ExpressionKind::COMPOSITE_LITERAL: // vec <- { }
             case ExpressionKind::GROUPING: { // simple <- ( expression )
                 shared_ptr<WrappedValue> sourceWrappedValue = wrappedValueForExpression(valueExpression);
                 if (sourceWrappedValue == nullptr)
@@ -1031,7 +1439,12 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
                 llvm::Value *targetValue = targetWrappedValue->getPointerValue();
                 if (targetValue == nullptr)
                     return;
-                builder->CreateStore(sourceValue, targetValue);
+                llvm::StoreInst *store = builder->CreateStore(sourceValue, targetValue, targetWrappedValue->getIsVolatile());
+                if (llvm::MDNode *tbaaAccessTag = targetWrappedValue->getTbaaAccessTag())
+                    store->setMetadata(llvm::LLVMContext::MD_tbaa, tbaaAccessTag);
+                // vectors behind a pointer are only guaranteed to be aligned as their lanes
+                if (sourceValue->getType()->isVectorTy() && !llvm::isa<llvm::AllocaInst>(targetValue->stripInBoundsOffsets()))
+                    store->setAlignment(alignForType(sourceValue->getType()->getScalarType()));
                 break;
             }
             default: {
@@ -1042,6 +1455,147 @@ void ModuleBuilder::buildAssignment(shared_ptr<WrappedValue> targetWrappedValue,
     }
 }
 
+llvm::AllocaInst *ModuleBuilder::buildLocalAlloca(llvm::Type *type, string name) {
+    // allocas in the entry block are static, so LLVM can share their stack slots
+    llvm::BasicBlock *entryBlock = &builder->GetInsertBlock()->getParent()->getEntryBlock();
+    llvm::IRBuilder<> entryBuilder(entryBlock, entryBlock->getFirstInsertionPt());
+    llvm::AllocaInst *alloca = entryBuilder.CreateAlloca(type, nullptr, name);
+
+    // local is alive from its declaration until the end of the current scope
+    builder->CreateLifetimeStart(alloca, builder->getInt64(sizeInBytesForType(type)));
+    scope->addAlloca(alloca);
+
+    return alloca;
+}
+
+void ModuleBuilder::buildDataChunks(int elementsCount, int chunkLanesCount, function<void(llvm::Value *, int)> buildChunk) {
+    int chunksCount = elementsCount / chunkLanesCount;
+    int tailLanesCount = elementsCount % chunkLanesCount;
+
+    if (chunksCount == 1) {
+        buildChunk(llvm::ConstantInt::get(typePtrInt, 0), chunkLanesCount);
+    } else if (chunksCount > 1) {
+        llvm::Function *fun = builder->GetInsertBlock()->getParent();
+        llvm::BasicBlock *preBlock = builder->GetInsertBlock();
+        llvm::BasicBlock *bodyBlock = llvm::BasicBlock::Create(*context, "chunk_body", fun);
+        llvm::BasicBlock *afterBlock = llvm::BasicBlock::Create(*context, "chunk_post");
+        builder->CreateBr(bodyBlock);
+
+        // body
+        builder->SetInsertPoint(bodyBlock);
+        llvm::PHINode *chunkIndexValue = builder->CreatePHI(typePtrInt, 2, "chunk_index");
+        chunkIndexValue->addIncoming(llvm::ConstantInt::get(typePtrInt, 0), preBlock);
+        llvm::Value *indexValue = builder->CreateMul(chunkIndexValue, llvm::ConstantInt::get(typePtrInt, chunkLanesCount), "", true, true);
+        buildChunk(indexValue, chunkLanesCount);
+        llvm::Value *nextChunkIndexValue = builder->CreateAdd(chunkIndexValue, llvm::ConstantInt::get(typePtrInt, 1), "", true, true);
+        chunkIndexValue->addIncoming(nextChunkIndexValue, builder->GetInsertBlock());
+        llvm::Value *isNextValue = builder->CreateICmpULT(nextChunkIndexValue, llvm::ConstantInt::get(typePtrInt, chunksCount));
+        builder->CreateCondBr(isNextValue, bodyBlock, afterBlock);
+
+        // after
+        fun->insert(fun->end(), afterBlock);
+        builder->SetInsertPoint(afterBlock);
+    }
+
+    // remaining elements use a narrower vector
+    if (tailLanesCount > 0)
+        buildChunk(llvm::ConstantInt::get(typePtrInt, chunksCount * chunkLanesCount), tailLanesCount);
+}
+
+void ModuleBuilder::buildLifetimesEnd() {
+    // nothing to do after a terminator
+    llvm::BasicBlock *block = builder->GetInsertBlock();
+    if (block == nullptr || block->getTerminator() != nullptr)
+        return;
+
+    for (llvm::AllocaInst *alloca : scope->getAllocas())
+        builder->CreateLifetimeEnd(alloca, builder->getInt64(sizeInBytesForType(alloca->getAllocatedType())));
+}
+
+bool ModuleBuilder::buildConstantCopy(shared_ptr<WrappedValue> targetWrappedValue, shared_ptr<ExpressionCompositeLiteral> expressionCompositeLiteral, bool isInitialization) {
+    llvm::Type *targetType = targetWrappedValue->getType();
+    if (sizeInBitsForType(targetType) / 8 < MIN_CONSTANT_COPY_SIZE)
+        return false;
+
+    vector<shared_ptr<Expression>> valueExpressions = expressionCompositeLiteral->getExpressions();
+    int targetCount = targetType->isArrayTy() ? targetType->getArrayNumElements() : targetType->getStructNumElements();
+    int count = min((int)valueExpressions.size(), targetCount);
+    if (targetType->isStructTy() && count != targetCount)
+        return false;
+
+    // split into constant values and the ones which have to be patched afterwards
+    vector<llvm::Constant *> constantValues;
+    vector<int> patchIndices;
+    for (int i=0; i<count; i++) {
+        llvm::Type *elementType = targetType->isArrayTy() ? targetType->getArrayElementType() : targetType->getStructElementType(i);
+        llvm::Constant *constantValue = constantForExpression(valueExpressions.at(i), elementType);
+        if (constantValue == nullptr) {
+            // non constant values could read the target, so they are only allowed if it is not used yet
+            if (!isInitialization)
+                return false;
+            constantValue = llvm::Constant::getNullValue(elementType);
+            patchIndices.push_back(i);
+        }
+        constantValues.push_back(constantValue);
+    }
+
+    // not worth it if most of the values are not constant
+    if (patchIndices.size() * 2 > count)
+        return false;
+
+    llvm::Value *targetPointerValue = targetWrappedValue->getPointerValue();
+    if (targetType->isArrayTy()) {
+        llvm::Type *elementType = targetType->getArrayElementType();
+
+        // zeros at the end are cleared instead of copied, as is the rest of a new variable
+        int copyCount = count;
+        while (copyCount > 0 && constantValues.at(copyCount - 1)->isNullValue())
+            copyCount--;
+        int clearCount = (isInitialization ? targetCount : count) - copyCount;
+
+        if (copyCount > 0) {
+            llvm::ArrayType *copyType = llvm::ArrayType::get(elementType, copyCount);
+            vector<llvm::Constant *> copyValues(constantValues.begin(), constantValues.begin() + copyCount);
+            llvm::GlobalVariable *global = constantGlobalForConstant(llvm::ConstantArray::get(copyType, copyValues));
+            builder->CreateMemCpy(targetPointerValue, alignForType(targetType), global, global->getAlign(), sizeInBytesForType(copyType));
+        }
+
+        if (clearCount > 0) {
+            llvm::Value *index[] = {
+                builder->getInt32(0),
+                builder->getInt32(copyCount)
+            };
+            llvm::Value *clearPointerValue = builder->CreateInBoundsGEP(targetType, targetPointerValue, index);
+            builder->CreateMemSet(clearPointerValue, builder->getInt8(0), sizeInBytesForType(llvm::ArrayType::get(elementType, clearCount)), alignForType(elementType));
+        }
+    } else {
+        llvm::Constant *constantStruct = llvm::ConstantStruct::get(targetWrappedValue->getStructType(), constantValues);
+        if (constantStruct->isNullValue()) {
+            builder->CreateMemSet(targetPointerValue, builder->getInt8(0), sizeInBytesForType(targetType), alignForType(targetType));
+        } else {
+            llvm::GlobalVariable *global = constantGlobalForConstant(constantStruct);
+            builder->CreateMemCpy(targetPointerValue, alignForType(targetType), global, global->getAlign(), sizeInBytesForType(targetType));
+        }
+    }
+
+    // and then store the remaining values
+    for (int i : patchIndices) {
+        shared_ptr<WrappedValue> wrappedValue = wrappedValueForExpression(valueExpressions.at(i));
+        if (wrappedValue == nullptr || wrappedValue->getValue() == nullptr) {
+            markErrorInvalidType(valueExpressions.at(i)->getLocation());
+            return true;
+        }
+        llvm::Value *index[] = {
+            builder->getInt32(0),
+            builder->getInt32(i)
+        };
+        llvm::Value *targetElementPointerValue = builder->CreateInBoundsGEP(targetType, targetPointerValue, index);
+        builder->CreateStore(wrappedValue->getValue(), targetElementPointerValue);
+    }
+
+    return true;
+}
+
 //
 // Expressions
 //
@@ -1081,6 +1635,11 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
     shared_ptr<WrappedValue> rightWrappedValue = wrappedValueForExpression(expressionBinary->getRight());
     if (leftWrappedValue == nullptr || rightWrappedValue == nullptr)
         return nullptr;
+
+    // whole data is processed in chunks
+    if (expressionBinary->getValueType()->isData())
+        return wrappedValueForDataOperation(expressionBinary, leftWrappedValue, rightWrappedValue);
+
     llvm::Value *leftValue = leftWrappedValue->getValue();
     llvm::Value *rightValue = rightWrappedValue->getValue();
 
@@ -1096,161 +1655,17 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
     // types will match in cases when it's important
     shared_ptr<ValueType> valueType = expressionBinary->getLeft()->getValueType();
 
-    llvm::Value *resultValue = nullptr;
-    switch (expressionBinary->getOperation()) {
-        // logical
-        case ExpressionBinaryOperation::OR: {
-            resultValue = builder->CreateLogicalOr(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::XOR: {
-            resultValue = builder->CreateXor(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::AND: {
-            resultValue = builder->CreateLogicalAnd(leftValue, rightValue);
-            break;
+    // vectors use the same instructions as their lanes, a single shift amount is applied to all of them
+    if (valueType->isVec()) {
+        if (!rightValue->getType()->isVectorTy()) {
+            llvm::FixedVectorType *vectorType = llvm::dyn_cast<llvm::FixedVectorType>(leftValue->getType());
+            rightValue = builder->CreateZExtOrTrunc(rightValue, vectorType->getElementType());
+            rightValue = builder->CreateVectorSplat(vectorType->getNumElements(), rightValue);
         }
+        valueType = valueType->getSubType();
+    }
 
-        // bitwise
-        case ExpressionBinaryOperation::BIT_TEST: {
-            // (value & test) != 0
-            llvm::Value *andResultValue = builder->CreateAnd(leftValue, rightValue);
-            llvm::Constant *constantZero = llvm::ConstantInt::get(andResultValue->getType(), 0);
-            llvm::Value *compareToZero = builder->CreateICmpEQ(andResultValue, constantZero);
-            resultValue = builder->CreateSelect(
-                compareToZero,
-                llvm::ConstantInt::getBool(typeBool, false),
-                llvm::ConstantInt::getBool(typeBool, true)
-            );
-            break;
-        }
-        case ExpressionBinaryOperation::BIT_OR: {
-            resultValue = builder->CreateOr(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::BIT_XOR: {
-            resultValue = builder->CreateXor(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::BIT_AND: {
-            resultValue = builder->CreateAnd(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::BIT_SHL: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateShl(leftValue, rightValue, "", true, false);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateShl(leftValue, rightValue, "", false, true);
-            break;
-        }
-        case ExpressionBinaryOperation::BIT_SHR: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateLShr(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateAShr(leftValue, rightValue);
-            break;
-        }
-
-        // comparison
-        case ExpressionBinaryOperation::EQUAL: {
-            if (valueType->isInteger() || valueType->isBool())
-                resultValue = builder->CreateICmpEQ(leftValue, rightValue);
-            else if (valueType->isFloat())
-                resultValue = builder->CreateFCmpOEQ(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::NOT_EQUAL: {
-            if (valueType->isInteger() || valueType->isBool())
-                resultValue = builder->CreateICmpNE(leftValue, rightValue);
-            else if (valueType->isFloat())
-                resultValue = builder->CreateFCmpONE(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::LESS: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateICmpULT(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateICmpSLT(leftValue, rightValue);
-            else if(valueType->isFloat())
-                resultValue = builder->CreateFCmpOLT(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::LESS_EQUAL: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateICmpULE(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateICmpSLE(leftValue, rightValue);
-            else if(valueType->isFloat())
-                resultValue = builder->CreateFCmpOLE(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::GREATER: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateICmpUGT(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateICmpSGT(leftValue, rightValue);
-            else if(valueType->isFloat())
-                resultValue = builder->CreateFCmpOGT(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::GREATER_EQUAL: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateICmpUGE(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateICmpSGE(leftValue, rightValue);
-            else if(valueType->isFloat())
-                resultValue = builder->CreateFCmpOGE(leftValue, rightValue);
-            break;
-        }
-
-        // mathematical
-        case ExpressionBinaryOperation::ADD: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateNUWAdd(leftValue, rightValue); // No Unsigned Wrap
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateNSWAdd(leftValue, rightValue); // No Signed Wrap
-            else if (valueType->isFloat())
-                resultValue = builder->CreateFAdd(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::SUB: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateNUWSub(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateNSWSub(leftValue, rightValue);
-            else if (valueType->isFloat())
-                resultValue = builder->CreateFSub(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::MUL: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateNUWMul(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateNSWMul(leftValue, rightValue);
-            else if (valueType->isFloat())
-                resultValue = builder->CreateFMul(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::DIV: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateUDiv(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateSDiv(leftValue, rightValue);
-            else if (valueType->isFloat())
-                resultValue = builder->CreateFDiv(leftValue, rightValue);
-            break;
-        }
-        case ExpressionBinaryOperation::MOD: {
-            if (valueType->isUnsignedInteger())
-                resultValue = builder->CreateURem(leftValue, rightValue);
-            else if (valueType->isSignedInteger())
-                resultValue = builder->CreateSRem(leftValue, rightValue);
-            else if (valueType->isFloat())
-                resultValue = builder->CreateFRem(leftValue, rightValue);
-            break;
-        }
-    }
+    llvm::Value *resultValue = valueForBinaryOperation(expressionBinary->getOperation(), valueType, leftValue, rightValue);
 
     if (resultValue == nullptr) {
         markErrorInvalidOperationBinary(
@@ -1266,6 +1681,10 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
     if (expressionBinary->getValueType()->isAddress())
         resultValue = builder->CreateIntToPtr(resultValue, typePtr);
 
+    // compared lanes become a mask
+    if (expressionBinary->getValueType()->isVec() && resultValue->getType()->getScalarType()->isIntegerTy(1))
+        resultValue = builder->CreateSExt(resultValue, llvmTypeForValueType(expressionBinary->getValueType()));
+
     return WrappedValue::wrappedValue(resultValue, expressionBinary->getValueType());
 }
 
@@ -1276,7 +1695,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
 
 shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<ExpressionCall> expressionCall) {
     if (llvm::Function *fun = scope->getFunction(expressionCall->getName())) {
-        return wrappedValueForCall(fun, fun->getFunctionType(), {}, expressionCall->getArgumentExpressions(), expressionCall->getValueType());
+        return wrappedValueForCall(fun, fun->getFunctionType(), fun->getAttributes(), funArgumentsPassedByPointerMap[fun], {}, expressionCall->getArgumentExpressions(), expressionCall->getValueType());
     }
 
     if (llvm::InlineAsm *rawFun = scope->getInlineAsm(expressionCall->getName())) {
@@ -1323,7 +1742,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
             llvm::Type *type = llvmTypeForValueType(expressionCast->getValueType(), false);
             llvm::AllocaInst *alloca = builder->CreateAlloca(type, nullptr, format("ch_{}", i));
             shared_ptr<WrappedValue> wrappedValue = WrappedValue::wrappedValue(alloca, expressionCast->getValueType());
-            buildAssignment(wrappedValue, expressionCompositeLiteral);
+            buildAssignment(wrappedValue, expressionCompositeLiteral, true);
             currentWrappedValue = wrappedValue;
             parentExpression = expressionCast;
 
@@ -1352,7 +1771,9 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
             // call expression?
             if (shared_ptr<ExpressionCall> expressionCall = dynamic_pointer_cast<ExpressionCall>(chainExpression)) {
                 string functionName = format("{}.{}", parentBlobName, expressionCall->getName());
-                llvm::Function *fun = scope->getFunction(functionName);
+                llvm::Function *fun = specializedFunction(parentExpression->getValueType(), expressionCall->getName());
+                if (fun == nullptr)
+                    fun = scope->getFunction(functionName);
                 if (fun == nullptr) {
                     markErrorNotDefined(expressionCall->getLocation(), format("function \"{}\"", expressionCall->getName()));
                     return nullptr;
@@ -1360,6 +1781,8 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
                 currentWrappedValue = wrappedValueForCall(
                     fun,
                     fun->getFunctionType(),
+                    fun->getAttributes(),
+                    funArgumentsPassedByPointerMap[fun],
                     {currentWrappedValue->getPointerValue()},
                     expressionCall->getArgumentExpressions(),
                     expressionCall->getValueType()
@@ -1370,6 +1793,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
                 llvm::Value *sourceValue = nullptr;
                 llvm::Value *sourcePointerValue = nullptr;
                 llvm::Type *sourceType = nullptr;
+                llvm::MDNode *tbaaAccessTag = nullptr;
 
                 // try member variable
                 if (optional<int> memberIndex = scope->getStructMemberIndex(parentBlobName, expressionValue->getIdentifier())) {
@@ -1380,15 +1804,19 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
 
                     llvm::Type *sourceStructType = currentWrappedValue->getStructType();
                     llvm::Value *sourceStructValue = currentWrappedValue->getPointerValue();
-                    llvm::Value *memberPtr = builder->CreateGEP(sourceStructType, sourceStructValue, index, format("gep_blob-{}", string(sourceStructValue->getName())));
+                    llvm::Value *memberPtr = builder->CreateInBoundsGEP(sourceStructType, sourceStructValue, index, format("gep_blob-{}", string(sourceStructValue->getName())));
 
                     sourceType = currentWrappedValue->getStructType()->getElementType(*memberIndex);
                     sourceValue = nullptr;
                     sourcePointerValue = memberPtr;
+                    tbaaAccessTag = tbaaAccessTagForMember(currentWrappedValue->getStructType(), *memberIndex, expressionValue->getValueType());
                 // try member function
                 } else {
                     string functionName = format("{}.{}", parentBlobName, expressionValue->getIdentifier());
-                    if (llvm::Function *fun = scope->getFunction(functionName)) {
+                    llvm::Function *fun = specializedFunction(parentExpression->getValueType(), expressionValue->getIdentifier());
+                    if (fun == nullptr)
+                        fun = scope->getFunction(functionName);
+                    if (fun != nullptr) {
                         sourceValue = fun;
                         sourcePointerValue = nullptr;
                         sourceType = fun->getType();
@@ -1400,7 +1828,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
                     return nullptr;   
                 }
 
-                currentWrappedValue = wrappedValueForValue(sourceValue, sourcePointerValue, sourceType, expressionValue);
+                currentWrappedValue = wrappedValueForValue(sourceValue, sourcePointerValue, sourceType, expressionValue, tbaaAccessTag);
                 parentExpression = chainExpression;
             } else {
                 markErrorInvalidType(expressionValue->getLocation());
@@ -1418,18 +1846,6 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
                     if (expressionCall->getName().compare(member.first) == 0) {
                         llvm::StructType *structType = scope->getProtoStructType(parentProtoName);
 
-                        shared_ptr<ValueType> funValueType = member.second->getSubType();
-                        llvm::Type *type = llvmTypeForValueType(funValueType);
-                        llvm::FunctionType *funType = llvm::dyn_cast<llvm::FunctionType>(type);
-
-                        // fun value
-                        llvm::Value *funIndexMember[] = {
-                            builder->getInt32(0),
-                            builder->getInt32(i+1)
-                        };
-                        llvm::Value *funMemberPtr = builder->CreateGEP(structType, currentWrappedValue->getPointerValue(), funIndexMember);
-                        llvm::LoadInst *funPointerLoad = builder->CreateLoad(typePtr, funMemberPtr);
-
                         // it value
                         llvm::Value *itIndexMember[] = {
                             builder->getInt32(0),
@@ -1437,12 +1853,53 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
                         };
 
                         llvm::Value *sourcePointer = currentWrappedValue->getPointerValue();
-                        llvm::Value *protoMemberPointer = builder->CreateGEP(structType, sourcePointer, itIndexMember, format("gep_proto-{}", string(sourcePointer->getName())));
+                        llvm::Value *protoMemberPointer = builder->CreateInBoundsGEP(structType, sourcePointer, itIndexMember, format("gep_proto-{}", string(sourcePointer->getName())));
                         llvm::LoadInst *blobMemberPointer = builder->CreateLoad(typePtr, protoMemberPointer, format("ld_proto-{}", string(protoMemberPointer->getName())));
 
+                        // implementing blob is known, so the function can be called directly
+                        llvm::Function *fun = nullptr;
+                        if (optional<string> blobName = expressionCall->getDevirtualizedBlobName())
+                            fun = scope->getFunction(format("{}.{}", *blobName, member.first));
+
+                        llvm::Value *callee;
+                        llvm::FunctionType *funType;
+                        llvm::AttributeList funAttributes;
+                        vector<bool> argumentsPassedByPointer;
+                        if (fun != nullptr) {
+                            callee = fun;
+                            funType = fun->getFunctionType();
+                            funAttributes = fun->getAttributes();
+                            argumentsPassedByPointer = funArgumentsPassedByPointerMap[fun];
+                        } else {
+                            shared_ptr<ValueType> funValueType = member.second->getSubType();
+                            funType = llvm::dyn_cast<llvm::FunctionType>(llvmTypeForValueType(funValueType));
+                            funAttributes = funAttributesForSignature(*funValueType->getArgumentTypes(), funValueType->getReturnType());
+                            argumentsPassedByPointer = argumentsPassedByPointerForSignature(*funValueType->getArgumentTypes(), false);
+
+                            // vtable
+                            llvm::Value *vtableIndexMember[] = {
+                                builder->getInt32(0),
+                                builder->getInt32(1)
+                            };
+                            llvm::Value *vtableMemberPtr = builder->CreateInBoundsGEP(structType, sourcePointer, vtableIndexMember);
+                            llvm::LoadInst *vtablePointerLoad = builder->CreateLoad(typePtr, vtableMemberPtr);
+
+                            // fun value, vtables are constant
+                            llvm::Value *funIndexMember[] = {
+                                builder->getInt32(0),
+                                builder->getInt32(i)
+                            };
+                            llvm::Value *funMemberPtr = builder->CreateInBoundsGEP(vtableTypeForProto(parentProtoName), vtablePointerLoad, funIndexMember);
+                            llvm::LoadInst *funPointerLoad = builder->CreateLoad(typePtr, funMemberPtr);
+                            funPointerLoad->setMetadata(llvm::LLVMContext::MD_invariant_load, llvm::MDNode::get(*context, {}));
+                            callee = funPointerLoad;
+                        }
+
                         currentWrappedValue = wrappedValueForCall(
-                            funPointerLoad,
+                            callee,
                             funType,
+                            funAttributes,
+                            argumentsPassedByPointer,
                             {blobMemberPointer},
                             expressionCall->getArgumentExpressions(),
                             expressionCall->getValueType()
@@ -1456,18 +1913,37 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
                 for (int i=0; i<members.size(); i++) {
                     pair<string, shared_ptr<ValueType>> member = members.at(i);
                     if (expressionValue->getIdentifier().compare(member.first) == 0) {
+                        llvm::Value *vtableIndex[] = {
+                            builder->getInt32(0),
+                            builder->getInt32(1)
+                        };
+                        llvm::Value *sourcePointer = currentWrappedValue->getPointerValue();
+                        llvm::Value *vtableMemberPointer = builder->CreateInBoundsGEP(currentWrappedValue->getStructType(), sourcePointer, vtableIndex, format("gep-proto-{}", string(sourcePointer->getName())));
+                        llvm::Value *vtablePointer = builder->CreateLoad(typePtr, vtableMemberPointer, format("ld_proto-{}", string(vtableMemberPointer->getName())));
+
                         llvm::Value *index[] = {
                             builder->getInt32(0),
-                            builder->getInt32(i+1)
+                            builder->getInt32(i)
                         };
+                        llvm::Value *vtableEntryPointer = builder->CreateInBoundsGEP(vtableTypeForProto(parentProtoName), vtablePointer, index);
+
                         // function type has to be treated as a pointer (we cannot load a function)
                         llvm::Type *pointeeType = typePtr;
-                        if (!member.second->getSubType()->isFunction())
+                        llvm::Value *blobMemberPointer = vtableEntryPointer;
+                        // variables are stored as offsets into the implementing blob
+                        if (!member.second->getSubType()->isFunction()) {
                             pointeeType = llvmTypeForValueType(member.second->getSubType());
 
-                        llvm::Value *sourcePointer = currentWrappedValue->getPointerValue();
-                        llvm::Value *protoMemberPointer = builder->CreateGEP(currentWrappedValue->getStructType(), sourcePointer, index, format("gep-proto-{}", string(sourcePointer->getName())));
-                        llvm::Value *blobMemberPointer = builder->CreateLoad(typePtr, protoMemberPointer, format("ld_proto-{}", string(protoMemberPointer->getName())));
+                            llvm::Value *itIndex[] = {
+                                builder->getInt32(0),
+                                builder->getInt32(0)
+                            };
+                            llvm::Value *itMemberPointer = builder->CreateInBoundsGEP(currentWrappedValue->getStructType(), sourcePointer, itIndex);
+                            llvm::Value *itPointer = builder->CreateLoad(typePtr, itMemberPointer);
+                            llvm::LoadInst *offsetLoad = builder->CreateLoad(typePtrInt, vtableEntryPointer);
+                            offsetLoad->setMetadata(llvm::LLVMContext::MD_invariant_load, llvm::MDNode::get(*context, {}));
+                            blobMemberPointer = builder->CreateInBoundsGEP(typeI8, itPointer, offsetLoad, format("gep_proto-{}", string(sourcePointer->getName())));
+                        }
 
                         currentWrappedValue = wrappedValueForValue(nullptr, blobMemberPointer, pointeeType, expressionValue);
                         parentExpression = chainExpression;
@@ -1520,6 +1996,16 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
         return WrappedValue::wrappedValue(constantStruct, expressionCompositeLiteral->getValueType());
     } else if (expressionCompositeLiteral->getValueType()->isPointer()) {
         return wrappedValueForExpression(expressionCompositeLiteral->getExpressions().at(0));
+    } else if (expressionCompositeLiteral->getValueType()->isVec()) {
+        // lanes are inserted one by one, constant ones are folded into a constant vector
+        llvm::Value *vectorValue = llvm::PoisonValue::get(type);
+        for (int i=0; i<expressionCompositeLiteral->getExpressions().size(); i++) {
+            shared_ptr<WrappedValue> laneWrappedValue = wrappedValueForExpression(expressionCompositeLiteral->getExpressions().at(i));
+            if (laneWrappedValue == nullptr)
+                return nullptr;
+            vectorValue = builder->CreateInsertElement(vectorValue, laneWrappedValue->getValue(), builder->getInt32(i));
+        }
+        return WrappedValue::wrappedValue(vectorValue, expressionCompositeLiteral->getValueType());
     }
 
     // Otherwise try normal dynamic alloca
@@ -1531,7 +2017,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
 
     llvm::AllocaInst *alloca = builder->CreateAlloca(type, nullptr);
     shared_ptr<WrappedValue> wrappedValue = WrappedValue::wrappedValue(alloca, expressionCompositeLiteral->getValueType());
-    buildAssignment(wrappedValue, expressionCompositeLiteral);
+    buildAssignment(wrappedValue, expressionCompositeLiteral, true);
     return wrappedValue;
 }
 
@@ -1552,16 +2038,18 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
     llvm::BasicBlock *elseBlock = llvm::BasicBlock::Create(*context, "elseBlock");
     llvm::BasicBlock *mergeBlock = llvm::BasicBlock::Create(*context, "mergeBlock");
 
+    llvm::MDNode *branchWeights = branchWeightsForLikelihood(expressionIfElse->getIsConditionLikely());
     if (expressionIfElse->getElseExpression() != nullptr) {
-        builder->CreateCondBr(conditionValue, thenBlock, elseBlock);
+        builder->CreateCondBr(conditionValue, thenBlock, elseBlock, branchWeights);
     } else {
-        builder->CreateCondBr(conditionValue, thenBlock, mergeBlock);
+        builder->CreateCondBr(conditionValue, thenBlock, mergeBlock, branchWeights);
     }
 
     // Then
     scope->pushLevel();
     builder->SetInsertPoint(thenBlock);
     llvm::Value *thenValue = wrappedValueForExpression(expressionIfElse->getThenExpression())->getValue();
+    buildLifetimesEnd();
     builder->CreateBr(mergeBlock);
     thenBlock = builder->GetInsertBlock();
     scope->popLevel();
@@ -1576,6 +2064,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
         if (wrappedElseValue == nullptr)
             return nullptr;
         elseValue = wrappedElseValue->getValue();
+        buildLifetimesEnd();
         builder->CreateBr(mergeBlock);
         elseBlock = builder->GetInsertBlock();
         scope->popLevel();
@@ -1681,7 +2170,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForExpression(shared_ptr<Exp
             if (valueType->isUnsignedInteger()) {
                 resultValue = builder->CreateNeg(value);
             } else if (valueType->isSignedInteger()) {
-                resultValue = builder->CreateNSWNeg(value);
+                resultValue = isWrapping ? builder->CreateNeg(value) : builder->CreateNSWNeg(value);
             } else if (valueType->isFloat()) {
                 resultValue = builder->CreateFNeg(value);
             }
@@ -1747,7 +2236,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForBuiltIn(shared_ptr<Wrappe
 
     if (expressionValue != nullptr) {
         isCount = expressionValue->getIdentifier().compare("count") == 0;
-        isVal = expressionValue->getIdentifier().compare("val") == 0;
+        isVal = expressionValue->getIdentifier().compare("val") == 0 || expressionValue->getIdentifier().compare("vol") == 0;
         isVadr = expressionValue->getIdentifier().compare("vadr") == 0;
         isAdr = expressionValue->getIdentifier().compare("adr") == 0;
         isSize = expressionValue->getIdentifier().compare("size") == 0;
@@ -1755,6 +2244,20 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForBuiltIn(shared_ptr<Wrappe
         isVal = expressionCall->getName().compare("val") == 0;
     }
 
+    // Reductions over data and vectors
+    bool isParentCollection = parentExpression->getValueType()->isData() || parentExpression->getValueType()->isVec();
+    if (isParentCollection && expressionValue != nullptr && expressionValue->getValueKind() == ExpressionValueKind::BUILT_IN_REDUCTION)
+        return wrappedValueForReduction(parentWrappedValue, parentExpression, expressionValue);
+
+    // Bit and math operations on numbers and vectors
+    if (shared_ptr<WrappedValue> intrinsicWrappedValue = wrappedValueForIntrinsic(parentWrappedValue, parentExpression, expression))
+        return intrinsicWrappedValue;
+
+    // Cache and alignment hints on pointers and addresses
+    bool isParentAddress = parentExpression->getValueType()->isPointer() || parentExpression->getValueType()->getKind() == ValueTypeKind::A;
+    if (isParentAddress && expressionCall != nullptr && !isVal)
+        return wrappedValueForMemoryHint(parentWrappedValue, parentExpression, expressionCall);
+
     // Return quickly if not a built-in
     if (!isCount && !isVal && !isVadr && !isAdr && !isSize)
         return nullptr;
@@ -1773,6 +2276,13 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForBuiltIn(shared_ptr<Wrappe
             markErrorNoTypeForPointer(parentExpression->getLocation());
             return nullptr; 
         }
+        // call through a function pointer
+        if (expressionCall != nullptr && pointeeValueType->isFunction()) {
+            llvm::FunctionType *funType = llvm::dyn_cast<llvm::FunctionType>(pointeeType);
+            llvm::AttributeList funAttributes = funAttributesForSignature(*pointeeValueType->getArgumentTypes(), pointeeValueType->getReturnType());
+            vector<bool> argumentsPassedByPointer = argumentsPassedByPointerForSignature(*pointeeValueType->getArgumentTypes(), false);
+            return wrappedValueForCall(parentWrappedValue->getValue(), funType, funAttributes, argumentsPassedByPointer, {}, expressionCall->getArgumentExpressions(), expressionCall->getValueType());
+        }
         return wrappedValueForValue(nullptr, parentWrappedValue->getValue(), pointeeType, expression);
     } else if (parentWrappedValue->isPointer() && isVadr) {
         llvm::Value *pointerValue = parentWrappedValue->getValue();
@@ -1787,7 +2297,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForBuiltIn(shared_ptr<Wrappe
             builder->getInt32(0),
             builder->getInt32(0)
         };
-        llvm::Value *memberPtr = builder->CreateGEP(structType, parentWrappedValue->getPointerValue(), index);
+        llvm::Value *memberPtr = builder->CreateInBoundsGEP(structType, parentWrappedValue->getPointerValue(), index);
         llvm::LoadInst *pointerLoad = builder->CreateLoad(typePtr, memberPtr);
         llvm::LoadInst *pointeeLoad = builder->CreateLoad(typePtr, pointerLoad);
         return WrappedValue::wrappedValue(pointeeLoad, ValueType::A);
@@ -1806,14 +2316,343 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForBuiltIn(shared_ptr<Wrappe
     return nullptr;
 }
 
-shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCall(llvm::Value *callee, llvm::FunctionType *funType, vector<llvm::Value*> implicitArguments, vector<shared_ptr<Expression>> argumentExpressions, shared_ptr<ValueType> valueType) {
+shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForIntrinsic(shared_ptr<WrappedValue> parentWrappedValue, shared_ptr<Expression> parentExpression, shared_ptr<Expression> expression) {
+    shared_ptr<ExpressionValue> expressionValue = dynamic_pointer_cast<ExpressionValue>(expression);
+    shared_ptr<ExpressionCall> expressionCall = dynamic_pointer_cast<ExpressionCall>(expression);
+
+    // numbers and vectors of them (lane by lane)
+    shared_ptr<ValueType> parentValueType = parentExpression->getValueType();
+    shared_ptr<ValueType> elementValueType = parentValueType->isVec() ? parentValueType->getSubType() : parentValueType;
+    if (!elementValueType->isNumeric() || elementValueType->getKind() == ValueTypeKind::A)
+        return nullptr;
+    bool isFloat = elementValueType->isFloat();
+    bool isSigned = elementValueType->isSignedInteger();
+
+    string name;
+    if (expressionValue != nullptr && expressionValue->getValueKind() == ExpressionValueKind::BUILT_IN_INTRINSIC)
+        name = expressionValue->getIdentifier();
+    else if (expressionCall != nullptr)
+        name = expressionCall->getName();
+    else
+        return nullptr;
+
+    llvm::Value *value = parentWrappedValue->getValue();
+    if (value == nullptr)
+        return nullptr;
+    llvm::Type *type = value->getType();
+
+    vector<llvm::Value *> argumentValues;
+    if (expressionCall != nullptr) {
+        for (shared_ptr<Expression> argumentExpression : expressionCall->getArgumentExpressions()) {
+            shared_ptr<WrappedValue> argumentWrappedValue = wrappedValueForExpression(argumentExpression);
+            if (argumentWrappedValue == nullptr)
+                return nullptr;
+            argumentValues.push_back(argumentWrappedValue->getValue());
+        }
+    }
+
+    llvm::Value *resultValue = nullptr;
+    if (expressionValue != nullptr) {
+        if (name.compare("popcount") == 0)
+            resultValue = builder->CreateUnaryIntrinsic(llvm::Intrinsic::ctpop, value);
+        // zero gives the number of bits
+        else if (name.compare("clz") == 0)
+            resultValue = builder->CreateIntrinsic(llvm::Intrinsic::ctlz, {type}, {value, builder->getFalse()});
+        else if (name.compare("ctz") == 0)
+            resultValue = builder->CreateIntrinsic(llvm::Intrinsic::cttz, {type}, {value, builder->getFalse()});
+        else if (name.compare("bswap") == 0 && type->getScalarSizeInBits() % 16 == 0)
+            resultValue = builder->CreateUnaryIntrinsic(llvm::Intrinsic::bswap, value);
+        else if (name.compare("sqrt") == 0)
+            resultValue = builder->CreateUnaryIntrinsic(llvm::Intrinsic::sqrt, value);
+        else if (name.compare("abs") == 0 && isFloat)
+            resultValue = builder->CreateUnaryIntrinsic(llvm::Intrinsic::fabs, value);
+        // minimum value stays as it is
+        else if (name.compare("abs") == 0)
+            resultValue = builder->CreateIntrinsic(llvm::Intrinsic::abs, {type}, {value, builder->getFalse()});
+        else if (name.compare("floor") == 0)
+            resultValue = builder->CreateUnaryIntrinsic(llvm::Intrinsic::floor, value);
+        else if (name.compare("ceil") == 0)
+            resultValue = builder->CreateUnaryIntrinsic(llvm::Intrinsic::ceil, value);
+    } else if (argumentValues.size() == 1) {
+        // rotation is a funnel shift of the value with itself
+        if (name.compare("rotl") == 0)
+            resultValue = builder->CreateIntrinsic(llvm::Intrinsic::fshl, {type}, {value, value, argumentValues.at(0)});
+        else if (name.compare("rotr") == 0)
+            resultValue = builder->CreateIntrinsic(llvm::Intrinsic::fshr, {type}, {value, value, argumentValues.at(0)});
+        else if (name.compare("min") == 0 && isFloat)
+            resultValue = builder->CreateMinNum(value, argumentValues.at(0));
+        else if (name.compare("min") == 0)
+            resultValue = builder->CreateBinaryIntrinsic(isSigned ? llvm::Intrinsic::smin : llvm::Intrinsic::umin, value, argumentValues.at(0));
+        else if (name.compare("max") == 0 && isFloat)
+            resultValue = builder->CreateMaxNum(value, argumentValues.at(0));
+        else if (name.compare("max") == 0)
+            resultValue = builder->CreateBinaryIntrinsic(isSigned ? llvm::Intrinsic::smax : llvm::Intrinsic::umax, value, argumentValues.at(0));
+    } else if (argumentValues.size() == 2 && name.compare("fma") == 0) {
+        resultValue = builder->CreateIntrinsic(llvm::Intrinsic::fma, {type}, {value, argumentValues.at(0), argumentValues.at(1)});
+    }
+
+    if (resultValue == nullptr) {
+        markErrorInvalidBuiltIn(expression->getLocation(), name);
+        return nullptr;
+    }
+
+    return WrappedValue::wrappedValue(resultValue, expression->getValueType());
+}
+
+shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForMemoryHint(shared_ptr<WrappedValue> parentWrappedValue, shared_ptr<Expression> parentExpression, shared_ptr<ExpressionCall> expressionCall) {
+    llvm::Value *pointerValue = parentWrappedValue->getValue();
+    if (pointerValue == nullptr)
+        return nullptr;
+
+    vector<llvm::Value *> argumentValues;
+    for (shared_ptr<Expression> argumentExpression : expressionCall->getArgumentExpressions()) {
+        shared_ptr<WrappedValue> argumentWrappedValue = wrappedValueForExpression(argumentExpression);
+        if (argumentWrappedValue == nullptr)
+            return nullptr;
+        argumentValues.push_back(argumentWrappedValue->getValue());
+    }
+
+    if (expressionCall->getName().compare("prefetch") == 0 && argumentValues.size() == 2) {
+        llvm::ConstantInt *isWriteValue = llvm::dyn_cast<llvm::ConstantInt>(argumentValues.at(0));
+        llvm::ConstantInt *localityValue = llvm::dyn_cast<llvm::ConstantInt>(argumentValues.at(1));
+        if (isWriteValue != nullptr && localityValue != nullptr) {
+            // the last argument selects the data cache
+            builder->CreateIntrinsic(
+                llvm::Intrinsic::prefetch,
+                {typePtr},
+                {pointerValue, builder->getInt32(isWriteValue->isZero() ? 0 : 1), builder->getInt32(localityValue->getZExtValue()), builder->getInt32(1)}
+            );
+            return WrappedValue::wrappedNone(typeVoid, ValueType::NONE);
+        }
+    } else if (expressionCall->getName().compare("storeNT") == 0 && argumentValues.size() == 1) {
+        // vectors are only expected to be aligned as their lanes
+        llvm::Value *value = argumentValues.at(0);
+        llvm::StoreInst *store = builder->CreateAlignedStore(value, pointerValue, alignForType(value->getType()->getScalarType()));
+        store->setMetadata(llvm::LLVMContext::MD_nontemporal, llvm::MDNode::get(*context, llvm::ConstantAsMetadata::get(builder->getInt32(1))));
+        if (llvm::MDNode *tbaaAccessTag = tbaaAccessTagForValueType(parentExpression->getValueType()->getSubType()))
+            store->setMetadata(llvm::LLVMContext::MD_tbaa, tbaaAccessTag);
+        return WrappedValue::wrappedNone(typeVoid, ValueType::NONE);
+    } else if (expressionCall->getName().compare("assumeAligned") == 0 && argumentValues.size() == 1) {
+        // the same pointer is returned, the assumption holds for all of its uses after this point
+        if (llvm::ConstantInt *alignmentValue = llvm::dyn_cast<llvm::ConstantInt>(argumentValues.at(0))) {
+            builder->CreateAlignmentAssumption(llvmModule->getDataLayout(), pointerValue, alignmentValue->getZExtValue());
+            return WrappedValue::wrappedValue(pointerValue, expressionCall->getValueType());
+        }
+    }
+
+    markErrorInvalidBuiltIn(expressionCall->getLocation(), expressionCall->getName());
+    return nullptr;
+}
+
+shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForReduction(shared_ptr<WrappedValue> parentWrappedValue, shared_ptr<Expression> parentExpression, shared_ptr<ExpressionValue> expressionValue) {
+    if (builder->GetInsertBlock() == nullptr) {
+        markErrorInvalidConstant(expressionValue->getLocation());
+        return nullptr;
+    }
+
+    bool isSum = expressionValue->getIdentifier().compare("sum") == 0;
+    bool isMin = expressionValue->getIdentifier().compare("min") == 0;
+    bool isMax = expressionValue->getIdentifier().compare("max") == 0;
+    bool isAny = expressionValue->getIdentifier().compare("any") == 0;
+
+    shared_ptr<ValueType> elementValueType = parentExpression->getValueType()->getSubType();
+    bool isFloat = elementValueType->isFloat();
+    bool isSigned = elementValueType->isSignedInteger();
+
+    // float sums are done lane by lane, so their order is allowed to change
+    llvm::IRBuilderBase::FastMathFlagGuard fastMathFlagGuard(*builder);
+    if (isSum && isFloat) {
+        llvm::FastMathFlags fastMathFlags;
+        fastMathFlags.setAllowReassoc();
+        builder->setFastMathFlags(fastMathFlags);
+    }
+
+    auto combinedValue = [&](llvm::Value *firstValue, llvm::Value *secondValue) -> llvm::Value * {
+        if (isSum)
+            return isFloat ? builder->CreateFAdd(firstValue, secondValue) : builder->CreateAdd(firstValue, secondValue);
+        else if (isMin && isFloat)
+            return builder->CreateMinNum(firstValue, secondValue);
+        else if (isMin)
+            return builder->CreateBinaryIntrinsic(isSigned ? llvm::Intrinsic::smin : llvm::Intrinsic::umin, firstValue, secondValue);
+        else if (isMax && isFloat)
+            return builder->CreateMaxNum(firstValue, secondValue);
+        else if (isMax)
+            return builder->CreateBinaryIntrinsic(isSigned ? llvm::Intrinsic::smax : llvm::Intrinsic::umax, firstValue, secondValue);
+        else if (isAny)
+            return builder->CreateOr(firstValue, secondValue);
+        else
+            return builder->CreateAnd(firstValue, secondValue);
+    };
+
+    auto reducedValue = [&](llvm::Value *vectorValue) -> llvm::Value * {
+        if (isSum && isFloat)
+            return builder->CreateFAddReduce(llvm::ConstantFP::getNegativeZero(vectorValue->getType()->getScalarType()), vectorValue);
+        else if (isSum)
+            return builder->CreateAddReduce(vectorValue);
+        else if (isMin && isFloat)
+            return builder->CreateFPMinReduce(vectorValue);
+        else if (isMin)
+            return builder->CreateIntMinReduce(vectorValue, isSigned);
+        else if (isMax && isFloat)
+            return builder->CreateFPMaxReduce(vectorValue);
+        else if (isMax)
+            return builder->CreateIntMaxReduce(vectorValue, isSigned);
+        else if (isAny)
+            return builder->CreateOrReduce(vectorValue);
+        else
+            return builder->CreateAndReduce(vectorValue);
+    };
+
+    // vector lanes are reduced directly, masks are true where any of the bits is set
+    if (parentExpression->getValueType()->isVec()) {
+        llvm::Value *vectorValue = parentWrappedValue->getValue();
+        if (!isSum && !isMin && !isMax)
+            vectorValue = builder->CreateICmpNE(vectorValue, llvm::Constant::getNullValue(vectorValue->getType()));
+        return WrappedValue::wrappedValue(reducedValue(vectorValue), expressionValue->getValueType());
+    }
+
+    if (!parentWrappedValue->isArray()) {
+        markErrorInvalidBuiltIn(expressionValue->getLocation(), expressionValue->getIdentifier());
+        return nullptr;
+    }
+
+    // bools are stored one in each byte, but only its lowest bit holds the value
+    llvm::Type *elementType = parentWrappedValue->getArrayType()->getElementType();
+    llvm::Type *storedElementType = elementType->isIntegerTy(1) ? builder->getInt8Ty() : elementType;
+    int elementsCount = parentWrappedValue->getArrayType()->getNumElements();
+    int chunkLanesCount = max(DATA_CHUNK_SIZE / sizeInBitsForType(storedElementType), 1);
+    llvm::Value *pointerValue = parentWrappedValue->getPointerValue();
+
+    auto chunkValue = [&](llvm::Value *indexValue, int lanesCount) -> llvm::Value * {
+        llvm::Value *elementPointerValue = builder->CreateInBoundsGEP(storedElementType, pointerValue, indexValue);
+        llvm::Value *vectorValue = builder->CreateAlignedLoad(
+            llvm::FixedVectorType::get(storedElementType, lanesCount),
+            elementPointerValue,
+            alignForType(storedElementType)
+        );
+        if (elementType->isIntegerTy(1))
+            vectorValue = builder->CreateTrunc(vectorValue, llvm::FixedVectorType::get(elementType, lanesCount));
+        return vectorValue;
+    };
+
+    // full chunks are accumulated lane by lane and reduced once at the end
+    llvm::Value *resultValue = nullptr;
+    int chunksCount = elementsCount / chunkLanesCount;
+    if (chunksCount > 0) {
+        llvm::FixedVectorType *accumulatorType = llvm::FixedVectorType::get(elementType, chunkLanesCount);
+        int elementBitsCount = elementType->getScalarSizeInBits();
+        llvm::Constant *identityValue;
+        if (isSum)
+            identityValue = isFloat ? llvm::ConstantFP::getNegativeZero(accumulatorType) : llvm::Constant::getNullValue(accumulatorType);
+        else if (isMin && isFloat)
+            identityValue = llvm::ConstantFP::getInfinity(accumulatorType, false);
+        else if (isMin)
+            identityValue = isSigned ? llvm::ConstantInt::get(accumulatorType, llvm::APInt::getSignedMaxValue(elementBitsCount)) : llvm::Constant::getAllOnesValue(accumulatorType);
+        else if (isMax && isFloat)
+            identityValue = llvm::ConstantFP::getInfinity(accumulatorType, true);
+        else if (isMax)
+            identityValue = isSigned ? llvm::ConstantInt::get(accumulatorType, llvm::APInt::getSignedMinValue(elementBitsCount)) : llvm::Constant::getNullValue(accumulatorType);
+        else if (isAny)
+            identityValue = llvm::Constant::getNullValue(accumulatorType);
+        else
+            identityValue = llvm::Constant::getAllOnesValue(accumulatorType);
+
+        llvm::AllocaInst *accumulatorAlloca = buildLocalAlloca(accumulatorType, "a_reduce");
+        builder->CreateStore(identityValue, accumulatorAlloca);
+        buildDataChunks(chunksCount * chunkLanesCount, chunkLanesCount, [&](llvm::Value *indexValue, int lanesCount) {
+            llvm::Value *accumulatorValue = builder->CreateLoad(accumulatorType, accumulatorAlloca);
+            builder->CreateStore(combinedValue(accumulatorValue, chunkValue(indexValue, lanesCount)), accumulatorAlloca);
+        });
+        resultValue = reducedValue(builder->CreateLoad(accumulatorType, accumulatorAlloca));
+    }
+
+    // and the remaining ones on their own
+    int tailLanesCount = elementsCount % chunkLanesCount;
+    if (tailLanesCount > 0) {
+        llvm::Value *tailValue = reducedValue(chunkValue(llvm::ConstantInt::get(typePtrInt, chunksCount * chunkLanesCount), tailLanesCount));
+        resultValue = resultValue != nullptr ? combinedValue(resultValue, tailValue) : tailValue;
+    }
+
+    return WrappedValue::wrappedValue(resultValue, expressionValue->getValueType());
+}
+
+shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForDataOperation(shared_ptr<ExpressionBinary> expressionBinary, shared_ptr<WrappedValue> leftWrappedValue, shared_ptr<WrappedValue> rightWrappedValue) {
+    if (builder->GetInsertBlock() == nullptr) {
+        markErrorInvalidConstant(expressionBinary->getLocation());
+        return nullptr;
+    }
+
+    shared_ptr<ValueType> valueType = expressionBinary->getValueType();
+    llvm::ArrayType *arrayType = llvm::dyn_cast_or_null<llvm::ArrayType>(llvmTypeForValueType(valueType));
+    if (arrayType == nullptr) {
+        markErrorInvalidType(expressionBinary->getLocation());
+        return nullptr;
+    }
+    llvm::Type *elementType = arrayType->getElementType();
+    llvm::Align elementAlign = alignForType(elementType);
+    int chunkLanesCount = max(DATA_CHUNK_SIZE / sizeInBitsForType(elementType), 1);
+
+    // data is read through its pointer, a single value is the same for all the elements
+    bool isLeftData = expressionBinary->getLeft()->getValueType()->isData();
+    bool isRightData = expressionBinary->getRight()->getValueType()->isData();
+    llvm::Value *leftValue = isLeftData ? leftWrappedValue->getPointerValue() : leftWrappedValue->getValue();
+    llvm::Value *rightValue = isRightData ? rightWrappedValue->getPointerValue() : rightWrappedValue->getValue();
+    if (leftValue == nullptr || rightValue == nullptr)
+        return nullptr;
+    // shift amount may be of a different size
+    if (!isRightData && rightValue->getType() != elementType)
+        rightValue = builder->CreateZExtOrTrunc(rightValue, elementType);
+
+    llvm::AllocaInst *targetAlloca = buildLocalAlloca(arrayType, "a_data_op");
+    bool isValid = true;
+    buildDataChunks(arrayType->getNumElements(), chunkLanesCount, [&](llvm::Value *indexValue, int lanesCount) {
+        llvm::FixedVectorType *chunkType = llvm::FixedVectorType::get(elementType, lanesCount);
+        llvm::Value *leftChunkValue = isLeftData ?
+            builder->CreateAlignedLoad(chunkType, builder->CreateInBoundsGEP(elementType, leftValue, indexValue), elementAlign) :
+            builder->CreateVectorSplat(lanesCount, leftValue);
+        llvm::Value *rightChunkValue = isRightData ?
+            builder->CreateAlignedLoad(chunkType, builder->CreateInBoundsGEP(elementType, rightValue, indexValue), elementAlign) :
+            builder->CreateVectorSplat(lanesCount, rightValue);
+
+        llvm::Value *resultChunkValue = valueForBinaryOperation(expressionBinary->getOperation(), valueType->getSubType(), leftChunkValue, rightChunkValue);
+        if (resultChunkValue == nullptr) {
+            isValid = false;
+            return;
+        }
+        builder->CreateAlignedStore(resultChunkValue, builder->CreateInBoundsGEP(elementType, targetAlloca, indexValue), elementAlign);
+    });
+
+    if (!isValid) {
+        markErrorInvalidOperationBinary(
+            expressionBinary->getLocation(),
+            expressionBinary->getOperation(),
+            expressionBinary->getLeft()->getValueType(),
+            expressionBinary->getRight()->getValueType()
+        );
+        return nullptr;
+    }
+
+    return WrappedValue::wrappedValue(targetAlloca, valueType);
+}
+
+shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCall(llvm::Value *callee, llvm::FunctionType *funType, llvm::AttributeList funAttributes, vector<bool> argumentsPassedByPointer, vector<llvm::Value*> implicitArguments, vector<shared_ptr<Expression>> argumentExpressions, shared_ptr<ValueType> valueType) {
     vector<llvm::Value*> argValues;
 
+    // large results are written into a temporary provided by the caller
+    llvm::Type *resultType = nullptr;
+    llvm::AllocaInst *resultAlloca = nullptr;
+    if (funAttributes.hasParamAttr(0, llvm::Attribute::StructRet)) {
+        resultType = funAttributes.getParamStructRetType(0);
+        resultAlloca = builder->CreateAlloca(resultType, nullptr, "a_sret");
+        argValues.push_back(resultAlloca);
+    }
+
     // add implicit arguments
     for (llvm::Value *implicitArgValue : implicitArguments)
         argValues.push_back(implicitArgValue);
 
-    int implicitArgumentsCount = implicitArguments.size();
+    int implicitArgumentsCount = argValues.size();
+    int argumentsOffset = resultAlloca != nullptr ? 1 : 0;
 
     // add explicit arguments
     for (int i=implicitArgumentsCount; i < funType->getNumParams(); i++) {
@@ -1821,16 +2660,81 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCall(llvm::Value *callee,
         shared_ptr<WrappedValue> wrappedValue = wrappedValueForExpression(argumentExpression);
         if (wrappedValue == nullptr)
             return nullptr;
-        argValues.push_back(wrappedValue->getValue());
+        // erased blob functions still take the boxed values wrapped
+        if (i - argumentsOffset < argumentsPassedByPointer.size() && argumentsPassedByPointer.at(i - argumentsOffset)) {
+            llvm::Value *pointerValue = wrappedValue->getPointerValue();
+            // constants are in read-only memory, so a reference which may be written through gets a copy
+            llvm::GlobalVariable *global = llvm::dyn_cast<llvm::GlobalVariable>(pointerValue->stripInBoundsOffsets());
+            bool isReadOnly = funAttributes.hasParamAttr(i, llvm::Attribute::ByVal) || funAttributes.hasParamAttr(i, llvm::Attribute::ReadOnly);
+            if (global != nullptr && global->isConstant() && !isReadOnly) {
+                llvm::Type *type = wrappedValue->getType();
+                llvm::AllocaInst *alloca = builder->CreateAlloca(type, nullptr, "a_ref");
+                builder->CreateMemCpy(alloca, alignForType(type), pointerValue, alignForType(type), sizeInBytesForType(type));
+                pointerValue = alloca;
+            }
+            argValues.push_back(pointerValue);
+        } else if (blobSpecializations != nullptr && argumentExpression->getValueType()->isBoxed())
+            argValues.push_back(coercedBoxedValue(wrappedValue->getValue(), funType->getParamType(i)));
+        else
+            argValues.push_back(wrappedValue->getValue());
     }
 
-    return WrappedValue::wrappedValue(
-        builder->CreateCall(funType, callee, llvm::ArrayRef(argValues)),
-        valueType
-    );
+    llvm::CallInst *callInst = builder->CreateCall(funType, callee, llvm::ArrayRef(argValues));
+    callInst->setAttributes(funAttributes);
+
+    if (resultAlloca != nullptr)
+        return WrappedValue::wrappedPointerValue(resultAlloca, resultType, valueType);
+
+    // boxed results of erased blob functions are still wrapped
+    if (blobSpecializations != nullptr && valueType->isBoxed()) {
+        llvm::Value *resultValue = coercedBoxedValue(callInst, llvmTypeForValueType(valueType, true));
+        if (resultValue != callInst)
+            return WrappedValue::wrappedValue(resultValue, valueType);
+    }
+
+    return WrappedValue::wrappedValue(callInst, valueType);
 }
 
 shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCast(shared_ptr<WrappedValue> sourceWrappedValue, shared_ptr<ValueType> targetValueType) {
+    // specialized boxed values are cast like the types they hold
+    if (shared_ptr<ValueType> unboxedType = specializedUnboxedType(targetValueType)) {
+        shared_ptr<WrappedValue> unboxedWrappedValue = wrappedValueForCast(sourceWrappedValue, unboxedType);
+        if (unboxedWrappedValue == nullptr)
+            return nullptr;
+        return WrappedValue::wrappedValue(unboxedWrappedValue->getValue(), targetValueType);
+    }
+    if (shared_ptr<ValueType> unboxedType = specializedUnboxedType(sourceWrappedValue->getValueType()))
+        return wrappedValueForCast(WrappedValue::wrappedValue(sourceWrappedValue->getValue(), unboxedType), targetValueType);
+
+    shared_ptr<ValueType> sourceValueType = sourceWrappedValue->getValueType();
+    // scalar is splat into all the lanes
+    if (targetValueType->isVec() && !sourceValueType->isVec() && !sourceValueType->isData()) {
+        shared_ptr<WrappedValue> laneWrappedValue = sourceWrappedValue;
+        if (!sourceValueType->isEqual(targetValueType->getSubType()))
+            laneWrappedValue = wrappedValueForCast(sourceWrappedValue, targetValueType->getSubType());
+        if (laneWrappedValue == nullptr)
+            return nullptr;
+        return WrappedValue::wrappedValue(
+            builder->CreateVectorSplat(targetValueType->getValueArg(), laneWrappedValue->getValue()),
+            targetValueType
+        );
+    // data elements are loaded as lanes
+    } else if (targetValueType->isVec() && sourceValueType->isData()) {
+        llvm::Type *targetType = llvmTypeForValueType(targetValueType);
+        return WrappedValue::wrappedValue(
+            builder->CreateAlignedLoad(targetType, sourceWrappedValue->getPointerValue(), alignForType(targetType->getScalarType())),
+            targetValueType
+        );
+    // and lanes are stored as data elements
+    } else if (sourceValueType->isVec() && targetValueType->isData()) {
+        llvm::AllocaInst *targetAlloca = builder->CreateAlloca(llvmTypeForValueType(targetValueType));
+        builder->CreateAlignedStore(sourceWrappedValue->getValue(), targetAlloca, alignForType(sourceWrappedValue->getType()->getScalarType()));
+        return WrappedValue::wrappedValue(targetAlloca, targetValueType);
+    }
+
+    // vectors are cast with the same instructions as their lanes
+    bool areVec = sourceValueType->isVec() && targetValueType->isVec();
+
     // Figure out source type
     bool isSourceUInt = false;
     bool isSourceSInt = false;
@@ -1842,7 +2746,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCast(shared_ptr<WrappedVa
     int sourceSize = 0;
 
     // Unbox source type if required
-    ValueTypeKind sourceValueTypeKind = sourceWrappedValue->getValueType()->getKind();
+    ValueTypeKind sourceValueTypeKind = areVec ? sourceValueType->getSubType()->getKind() : sourceValueType->getKind();
     switch (sourceValueTypeKind) {
         case ValueTypeKind::UINT:
             isSourceUInt = true;
@@ -1932,7 +2836,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCast(shared_ptr<WrappedVa
     int targetSize = 0;
 
     // Unwrap target type if required
-    ValueTypeKind targetValueTypeKind = targetValueType->getKind();
+    ValueTypeKind targetValueTypeKind = areVec ? targetValueType->getSubType()->getKind() : targetValueType->getKind();
     switch (targetValueTypeKind) {
         case ValueTypeKind::UINT:
             isTargetUInt = true;
@@ -2115,7 +3019,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCast(shared_ptr<WrappedVa
         llvm::AllocaInst *targetAlloca = builder->CreateAlloca(targetType);
 
         int elementsCount = min(sourceSize, targetSize);
-        int elementSize = sizeInBitsForType(sourceWrappedValue->getArrayType()->getElementType()) / 8;
+        int elementSize = sizeInBytesForType(sourceWrappedValue->getArrayType()->getElementType());
 
         bool areElementTypesSame = sourceWrappedValue->getValueType()->getSubType()->isEqual(targetValueType->getSubType());
 
@@ -2123,9 +3027,9 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCast(shared_ptr<WrappedVa
         if (areElementTypesSame) {
             builder->CreateMemCpy(
                 targetAlloca,
-                llvm::MaybeAlign(1),
+                targetAlloca->getAlign(),
                 sourceWrappedValue->getPointerValue(),
-                llvm::MaybeAlign(1),
+                alignForType(sourceWrappedValue->getArrayType()),
                 elementsCount * elementSize
             );
         } else {
@@ -2141,7 +3045,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCast(shared_ptr<WrappedVa
                 if (llvm::Constant *sourceConstantValue = sourceWrappedValue->getConstantValue()) {
                     sourceMemberValue = sourceConstantValue->getAggregateElement(i);
                 } else {
-                    llvm::Value *sourceMemberPtr = builder->CreateGEP(sourceWrappedValue->getArrayType(), sourceWrappedValue->getPointerValue(), index);
+                    llvm::Value *sourceMemberPtr = builder->CreateInBoundsGEP(sourceWrappedValue->getArrayType(), sourceWrappedValue->getPointerValue(), index);
                     sourceMemberValue = builder->CreateLoad(sourceWrappedValue->getArrayType()->getArrayElementType(), sourceMemberPtr);
                 }
 
@@ -2157,7 +3061,7 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCast(shared_ptr<WrappedVa
                     return nullptr;
 
                 // get the target member
-                llvm::Value *targetMemberPtr = builder->CreateGEP(targetType, targetAlloca, index);
+                llvm::Value *targetMemberPtr = builder->CreateInBoundsGEP(targetType, targetAlloca, index);
 
                 // and finally store source member in the target member
                 builder->CreateStore(castSourceMemberValue->getValue(), targetMemberPtr);
@@ -2192,11 +3096,16 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForCast(shared_ptr<WrappedVa
     }
 }
 
-shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForValue(llvm::Value *value, llvm::Value *pointerValue, llvm::Type *type, shared_ptr<Expression> expression) {
+shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForValue(llvm::Value *value, llvm::Value *pointerValue, llvm::Type *type, shared_ptr<Expression> expression, llvm::MDNode *tbaaAccessTag) {
     if (builder->GetInsertBlock() == nullptr)
         return nullptr;
 
     if (shared_ptr<ExpressionValue> expressionValue = dynamic_pointer_cast<ExpressionValue>(expression)) {
+        // .vol is the same as .val, except that each access goes to memory
+        bool isVolatile = expressionValue->getIdentifier().compare("vol") == 0 && (
+            expressionValue->getValueKind() == ExpressionValueKind::BUILT_IN_VAL_SIMPLE ||
+            expressionValue->getValueKind() == ExpressionValueKind::BUILT_IN_VAL_DATA
+        );
         switch (expressionValue->getValueKind()) {
             case ExpressionValueKind::FUN:
             case ExpressionValueKind::SIMPLE:
@@ -2204,10 +3113,15 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForValue(llvm::Value *value,
                 if (value != nullptr) {
                     return WrappedValue::wrappedValue(value, expression->getValueType());
                 } else {
+                    // blob members are tagged by the caller with their path
+                    if (tbaaAccessTag == nullptr)
+                        tbaaAccessTag = tbaaAccessTagForValueType(expression->getValueType());
                     return WrappedValue::wrappedPointerValue(
                         pointerValue,
                         type,
-                        expression->getValueType()
+                        expression->getValueType(),
+                        tbaaAccessTag,
+                        isVolatile
                     );
                 }
             }
@@ -2216,6 +3130,14 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForValue(llvm::Value *value,
                 llvm::Value *indexValue = wrappedValueForExpression(expressionValue->getIndexExpression())->getValue();
                 if (indexValue == nullptr)
                     return nullptr;
+                // elements are always within the indexed data, unsigned indices are widened so the offset can't wrap either
+                llvm::GEPNoWrapFlags noWrapFlags = llvm::GEPNoWrapFlags::inBounds();
+                shared_ptr<ValueType> indexValueType = expressionValue->getIndexExpression()->getValueType();
+                if (indexValueType != nullptr && indexValueType->isUnsignedInteger() && indexValue->getType()->isIntegerTy()) {
+                    if (indexValue->getType()->getIntegerBitWidth() < typePtrInt->getBitWidth())
+                        indexValue = builder->CreateZExt(indexValue, typePtrInt);
+                    noWrapFlags = noWrapFlags | llvm::GEPNoWrapFlags::noUnsignedWrap();
+                }
                 llvm::Value *index[] = {
                     builder->getInt32(0),
                     indexValue
@@ -2225,20 +3147,19 @@ shared_ptr<WrappedValue> ModuleBuilder::wrappedValueForValue(llvm::Value *value,
                 llvm::Value *sourceValue = value;
                 if (sourceValue == nullptr)
                     sourceValue = pointerValue;
-                llvm::Value *elementPtr = builder->CreateGEP(sourceArrayType, sourceValue, index, format("gep_data-{}", string(sourceValue->getName())));
+                llvm::Value *elementPtr = builder->CreateGEP(sourceArrayType, sourceValue, index, format("gep_data-{}", string(sourceValue->getName())), noWrapFlags);
                 return WrappedValue::wrappedPointerValue(
                     elementPtr,
                     sourceArrayType->getArrayElementType(),
-                    expression->getValueType()
+                    expression->getValueType(),
+                    tbaaAccessTagForValueType(expression->getValueType()),
+                    isVolatile
                 );
             }
             default: {
                 break;
             }
         }
-    } else if (shared_ptr<ExpressionCall> expressionCall = dynamic_pointer_cast<ExpressionCall>(expression)) {
-        llvm::FunctionType *funType = llvm::dyn_cast<llvm::FunctionType>(type);
-        return wrappedValueForCall(pointerValue, funType, {}, expressionCall->getArgumentExpressions(), expressionCall->getValueType());
     }
     return nullptr;
 }
@@ -2300,6 +3221,9 @@ llvm::Type *ModuleBuilder::llvmTypeForValueType(shared_ptr<ValueType> valueType,
         case ValueTypeKind::A:
             return typePtr;
         case ValueTypeKind::BOXED:
+            // specialized values are stored unwrapped
+            if (shared_ptr<ValueType> unboxedType = specializedUnboxedType(valueType))
+                return llvmTypeForValueType(unboxedType);
             if (shouldUnbox && !valueType->isBoxedNamedType())
                 return llvmTypeForValueType(valueType->getSubType());
             else
@@ -2318,7 +3242,18 @@ llvm::Type *ModuleBuilder::llvmTypeForValueType(shared_ptr<ValueType> valueType,
 
             return llvm::ArrayType::get(subType, elementsCount);
         }
+        case ValueTypeKind::VEC: {
+            llvm::Type *subType = llvmTypeForValueType(valueType->getSubType());
+            if (subType == nullptr)
+                return nullptr;
+
+            return llvm::FixedVectorType::get(subType, valueType->getValueArg());
+        }
         case ValueTypeKind::BLOB: {
+            // generic blobs get a separate struct for each set of type arguments
+            if (optional<vector<shared_ptr<ValueType>>> typeArguments = specializedTypeArguments(valueType))
+                return specializedStructType(*(valueType->getBlobName()), *typeArguments);
+
             llvm::StructType *structType = scope->getStructType(*(valueType->getBlobName()));
             if (structType == nullptr)
                 markErrorNotDefined(nullptr, format("blob \"{}\"", *(valueType->getBlobName())));
@@ -2331,20 +3266,7 @@ llvm::Type *ModuleBuilder::llvmTypeForValueType(shared_ptr<ValueType> valueType,
             return structType;
         }
         case ValueTypeKind::FUN: {
-            // returnType
-            llvm::Type *functionReturnType = llvmTypeForValueType(valueType->getReturnType());
-
-            // argument types
-            vector<llvm::Type *> functionArgumentTypes;
-            vector<shared_ptr<ValueType>> argumentTypes = *(valueType->getArgumentTypes());
-            for (shared_ptr<ValueType> &argumentType : argumentTypes) {
-                llvm::Type *functionArgumentType = llvmTypeForValueType(argumentType);
-                    if (functionArgumentType == nullptr)
-                        return nullptr;
-                    functionArgumentTypes.push_back(functionArgumentType);
-            }
-
-            return llvm::FunctionType::get(functionReturnType, functionArgumentTypes, false);
+            return funTypeForSignature(*(valueType->getArgumentTypes()), valueType->getReturnType(), false);
         }
         case ValueTypeKind::PTR: {
             return typePtr;
@@ -2378,6 +3300,9 @@ int ModuleBuilder::sizeInBitsForType(llvm::Type *type) {
         llvm::Type *elementType = arrayType->getElementType();
         int elementSize = sizeInBitsForType(elementType);
         return elementSize * elementsCount;
+    } else if (type->isVectorTy()) {
+        llvm::FixedVectorType *vectorType = llvm::dyn_cast<llvm::FixedVectorType>(type);
+        return sizeInBitsForType(vectorType->getElementType()) * vectorType->getNumElements();
     } else if (type->isStructTy()) {
         int size = 0;
         llvm::StructType *structType = llvm::dyn_cast<llvm::StructType>(type);
@@ -2393,6 +3318,785 @@ int ModuleBuilder::sizeInBitsForType(llvm::Type *type) {
     return 0;
 }
 
+int ModuleBuilder::sizeInBytesForType(llvm::Type *type) {
+    // includes padding, unlike sizeInBitsForType
+    return llvmModule->getDataLayout().getTypeAllocSize(type);
+}
+
+llvm::Align ModuleBuilder::alignForType(llvm::Type *type) {
+    return llvmModule->getDataLayout().getABITypeAlign(type);
+}
+
+llvm::Value *ModuleBuilder::valueForBinaryOperation(ExpressionBinaryOperation operation, shared_ptr<ValueType> valueType, llvm::Value *leftValue, llvm::Value *rightValue) {
+    llvm::Value *resultValue = nullptr;
+    switch (operation) {
+        // logical
+        case ExpressionBinaryOperation::OR: {
+            resultValue = builder->CreateLogicalOr(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::XOR: {
+            resultValue = builder->CreateXor(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::AND: {
+            resultValue = builder->CreateLogicalAnd(leftValue, rightValue);
+            break;
+        }
+
+        // bitwise
+        case ExpressionBinaryOperation::BIT_TEST: {
+            // (value & test) != 0
+            llvm::Value *andResultValue = builder->CreateAnd(leftValue, rightValue);
+            llvm::Constant *constantZero = llvm::ConstantInt::get(andResultValue->getType(), 0);
+            llvm::Value *compareToZero = builder->CreateICmpEQ(andResultValue, constantZero);
+            resultValue = builder->CreateSelect(
+                compareToZero,
+                llvm::ConstantInt::getBool(typeBool, false),
+                llvm::ConstantInt::getBool(typeBool, true)
+            );
+            break;
+        }
+        case ExpressionBinaryOperation::BIT_OR: {
+            resultValue = builder->CreateOr(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::BIT_XOR: {
+            resultValue = builder->CreateXor(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::BIT_AND: {
+            resultValue = builder->CreateAnd(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::BIT_SHL: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateShl(leftValue, rightValue, "", !isWrapping, false);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateShl(leftValue, rightValue, "", false, !isWrapping);
+            break;
+        }
+        case ExpressionBinaryOperation::BIT_SHR: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateLShr(leftValue, rightValue);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateAShr(leftValue, rightValue);
+            break;
+        }
+
+        // comparison
+        case ExpressionBinaryOperation::EQUAL: {
+            if (valueType->isInteger() || valueType->isBool())
+                resultValue = builder->CreateICmpEQ(leftValue, rightValue);
+            else if (valueType->isFloat())
+                resultValue = builder->CreateFCmpOEQ(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::NOT_EQUAL: {
+            if (valueType->isInteger() || valueType->isBool())
+                resultValue = builder->CreateICmpNE(leftValue, rightValue);
+            else if (valueType->isFloat())
+                resultValue = builder->CreateFCmpONE(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::LESS: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateICmpULT(leftValue, rightValue);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateICmpSLT(leftValue, rightValue);
+            else if(valueType->isFloat())
+                resultValue = builder->CreateFCmpOLT(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::LESS_EQUAL: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateICmpULE(leftValue, rightValue);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateICmpSLE(leftValue, rightValue);
+            else if(valueType->isFloat())
+                resultValue = builder->CreateFCmpOLE(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::GREATER: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateICmpUGT(leftValue, rightValue);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateICmpSGT(leftValue, rightValue);
+            else if(valueType->isFloat())
+                resultValue = builder->CreateFCmpOGT(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::GREATER_EQUAL: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateICmpUGE(leftValue, rightValue);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateICmpSGE(leftValue, rightValue);
+            else if(valueType->isFloat())
+                resultValue = builder->CreateFCmpOGE(leftValue, rightValue);
+            break;
+        }
+
+        // mathematical
+        case ExpressionBinaryOperation::ADD: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateAdd(leftValue, rightValue, "", !isWrapping, false); // No Unsigned Wrap
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateAdd(leftValue, rightValue, "", false, !isWrapping); // No Signed Wrap
+            else if (valueType->isFloat())
+                resultValue = builder->CreateFAdd(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::SUB: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateSub(leftValue, rightValue, "", !isWrapping, false);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateSub(leftValue, rightValue, "", false, !isWrapping);
+            else if (valueType->isFloat())
+                resultValue = builder->CreateFSub(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::MUL: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateMul(leftValue, rightValue, "", !isWrapping, false);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateMul(leftValue, rightValue, "", false, !isWrapping);
+            else if (valueType->isFloat())
+                resultValue = builder->CreateFMul(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::DIV: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateUDiv(leftValue, rightValue);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateSDiv(leftValue, rightValue);
+            else if (valueType->isFloat())
+                resultValue = builder->CreateFDiv(leftValue, rightValue);
+            break;
+        }
+        case ExpressionBinaryOperation::MOD: {
+            if (valueType->isUnsignedInteger())
+                resultValue = builder->CreateURem(leftValue, rightValue);
+            else if (valueType->isSignedInteger())
+                resultValue = builder->CreateSRem(leftValue, rightValue);
+            else if (valueType->isFloat())
+                resultValue = builder->CreateFRem(leftValue, rightValue);
+            break;
+        }
+    }
+
+    return resultValue;
+}
+
+llvm::FunctionType *ModuleBuilder::funTypeForSignature(vector<shared_ptr<ValueType>> argumentTypes, shared_ptr<ValueType> returnType, bool isForeign) {
+    vector<llvm::Type *> funArgumentTypes;
+
+    // return type
+    llvm::Type *funReturnType = llvmTypeForValueType(returnType);
+    if (funReturnType == nullptr)
+        return nullptr;
+    // large results are returned through a pointer passed as the first argument
+    if (!isForeign && isPassedByPointer(funReturnType)) {
+        funArgumentTypes.push_back(typePtr);
+        funReturnType = typeVoid;
+    }
+
+    // arguments
+    vector<bool> argumentsPassedByPointer = argumentsPassedByPointerForSignature(argumentTypes, isForeign);
+    for (int i=0; i<argumentTypes.size(); i++) {
+        llvm::Type *funArgumentType = llvmTypeForValueType(argumentTypes.at(i));
+        if (funArgumentType == nullptr)
+            return nullptr;
+        if (argumentsPassedByPointer.at(i))
+            funArgumentType = typePtr;
+        funArgumentTypes.push_back(funArgumentType);
+    }
+
+    return llvm::FunctionType::get(funReturnType, funArgumentTypes, false);
+}
+
+llvm::AttributeList ModuleBuilder::funAttributesForSignature(vector<shared_ptr<ValueType>> argumentTypes, shared_ptr<ValueType> returnType) {
+    vector<llvm::AttributeSet> argumentsAttributes;
+
+    // result
+    llvm::Type *funReturnType = llvmTypeForValueType(returnType);
+    if (funReturnType != nullptr && isPassedByPointer(funReturnType)) {
+        llvm::AttrBuilder attrBuilder(*context);
+        attrBuilder.addStructRetAttr(funReturnType);
+        attrBuilder.addAttribute(llvm::Attribute::NoAlias);
+        attrBuilder.addAlignmentAttr(alignForType(funReturnType));
+        argumentsAttributes.push_back(llvm::AttributeSet::get(*context, attrBuilder));
+    }
+
+    // arguments
+    vector<bool> argumentsPassedByPointer = argumentsPassedByPointerForSignature(argumentTypes, false);
+    for (int i=0; i<argumentTypes.size(); i++) {
+        llvm::Type *funArgumentType = llvmTypeForValueType(argumentTypes.at(i));
+        llvm::AttrBuilder attrBuilder(*context);
+        if (argumentsPassedByPointer.at(i) && argumentTypes.at(i)->isReference()) {
+            // points directly to the caller's value
+            attrBuilder.addAttribute(llvm::Attribute::NonNull);
+            attrBuilder.addDereferenceableAttr(sizeInBytesForType(funArgumentType));
+            attrBuilder.addAlignmentAttr(alignForType(funArgumentType));
+        } else if (argumentsPassedByPointer.at(i)) {
+            // points to a copy made by the caller
+            attrBuilder.addByValAttr(funArgumentType);
+            attrBuilder.addAlignmentAttr(alignForType(funArgumentType));
+        }
+        argumentsAttributes.push_back(llvm::AttributeSet::get(*context, attrBuilder));
+    }
+
+    return llvm::AttributeList::get(*context, llvm::AttributeSet(), llvm::AttributeSet(), argumentsAttributes);
+}
+
+bool ModuleBuilder::isPassedByPointer(llvm::Type *type) {
+    return type->isAggregateType() && type->isSized() && sizeInBytesForType(type) >= MIN_AGGREGATE_COPY_SIZE;
+}
+
+bool ModuleBuilder::isPointerContainedInType(llvm::Type *type) {
+    if (type->isPointerTy())
+        return true;
+
+    // members of blobs which are only declared are not known
+    if (llvm::StructType *structType = llvm::dyn_cast<llvm::StructType>(type)) {
+        if (structType->isOpaque())
+            return true;
+        for (llvm::Type *elementType : structType->elements()) {
+            if (isPointerContainedInType(elementType))
+                return true;
+        }
+    } else if (llvm::ArrayType *arrayType = llvm::dyn_cast<llvm::ArrayType>(type)) {
+        return isPointerContainedInType(arrayType->getElementType());
+    } else if (llvm::VectorType *vectorType = llvm::dyn_cast<llvm::VectorType>(type)) {
+        return isPointerContainedInType(vectorType->getElementType());
+    }
+
+    return false;
+}
+
+vector<bool> ModuleBuilder::argumentsPassedByPointerForSignature(vector<shared_ptr<ValueType>> argumentTypes, bool isForeign) {
+    // references and large values, foreign functions keep their declared signature
+    vector<bool> argumentsPassedByPointer;
+    for (shared_ptr<ValueType> &argumentType : argumentTypes) {
+        llvm::Type *funArgumentType = llvmTypeForValueType(argumentType);
+        argumentsPassedByPointer.push_back(!isForeign && funArgumentType != nullptr && (argumentType->isReference() || isPassedByPointer(funArgumentType)));
+    }
+    return argumentsPassedByPointer;
+}
+
+llvm::Constant *ModuleBuilder::constantForExpression(shared_ptr<Expression> expression, llvm::Type *type) {
+    // nested literals are folded element by element
+    if (shared_ptr<ExpressionCompositeLiteral> expressionCompositeLiteral = dynamic_pointer_cast<ExpressionCompositeLiteral>(expression)) {
+        vector<shared_ptr<Expression>> elementExpressions = expressionCompositeLiteral->getExpressions();
+        vector<llvm::Constant *> elementValues;
+        if (llvm::ArrayType *arrayType = llvm::dyn_cast<llvm::ArrayType>(type)) {
+            if (elementExpressions.size() != arrayType->getNumElements())
+                return nullptr;
+            for (shared_ptr<Expression> &elementExpression : elementExpressions) {
+                llvm::Constant *elementValue = constantForExpression(elementExpression, arrayType->getElementType());
+                if (elementValue == nullptr)
+                    return nullptr;
+                elementValues.push_back(elementValue);
+            }
+            return llvm::ConstantArray::get(arrayType, elementValues);
+        } else if (llvm::StructType *structType = llvm::dyn_cast<llvm::StructType>(type)) {
+            if (elementExpressions.size() != structType->getNumElements())
+                return nullptr;
+            for (int i=0; i<elementExpressions.size(); i++) {
+                llvm::Constant *elementValue = constantForExpression(elementExpressions.at(i), structType->getElementType(i));
+                if (elementValue == nullptr)
+                    return nullptr;
+                elementValues.push_back(elementValue);
+            }
+            return llvm::ConstantStruct::get(structType, elementValues);
+        }
+        return nullptr;
+    }
+
+    // simple values are folded by the builder, so no code is emitted for them
+    shared_ptr<ValueType> valueType = expression->getValueType();
+    if (valueType == nullptr || !(valueType->isNumeric() || valueType->isBool()) || !isConstantExpression(expression))
+        return nullptr;
+
+    shared_ptr<WrappedValue> wrappedValue = wrappedValueForExpression(expression);
+    if (wrappedValue == nullptr || wrappedValue->getValue() == nullptr)
+        return nullptr;
+    llvm::Constant *constantValue = llvm::dyn_cast<llvm::Constant>(wrappedValue->getValue());
+    if (constantValue == nullptr || constantValue->getType() != type)
+        return nullptr;
+
+    return constantValue;
+}
+
+bool ModuleBuilder::isConstantExpression(shared_ptr<Expression> expression) {
+    // only simple expressions which can be folded without emitting any code
+    switch (expression->getKind()) {
+        case ExpressionKind::LITERAL:
+            return true;
+        case ExpressionKind::GROUPING:
+            return isConstantExpression(dynamic_pointer_cast<ExpressionGrouping>(expression)->getSubExpression());
+        case ExpressionKind::UNARY:
+            return isConstantExpression(dynamic_pointer_cast<ExpressionUnary>(expression)->getSubExpression());
+        case ExpressionKind::BINARY: {
+            shared_ptr<ExpressionBinary> expressionBinary = dynamic_pointer_cast<ExpressionBinary>(expression);
+            return isConstantExpression(expressionBinary->getLeft()) && isConstantExpression(expressionBinary->getRight());
+        }
+        default:
+            return false;
+    }
+}
+
+llvm::MDNode *ModuleBuilder::loopMetadataForStatementRepeat(shared_ptr<StatementRepeat> statementRepeat, llvm::MDNode *accessGroup) {
+    // first operand is the loop id itself
+    vector<llvm::Metadata *> properties = {nullptr};
+
+    if (statementRepeat->getIsNoUnroll())
+        properties.push_back(llvm::MDNode::get(*context, {llvm::MDString::get(*context, "llvm.loop.unroll.disable")}));
+
+    if (optional<int> unrollCount = statementRepeat->getUnrollCount()) {
+        properties.push_back(
+            llvm::MDNode::get(*context, {llvm::MDString::get(*context, "llvm.loop.unroll.count"), llvm::ConstantAsMetadata::get(builder->getInt32(*unrollCount))})
+        );
+    }
+
+    // width of 1 disables vectorization
+    if (optional<int> vectorizeWidth = statementRepeat->getVectorizeWidth()) {
+        if (*vectorizeWidth > 1)
+            properties.push_back(llvm::MDNode::get(*context, {llvm::MDString::get(*context, "llvm.loop.vectorize.enable"), llvm::ConstantAsMetadata::get(builder->getTrue())}));
+        properties.push_back(
+            llvm::MDNode::get(*context, {llvm::MDString::get(*context, "llvm.loop.vectorize.width"), llvm::ConstantAsMetadata::get(builder->getInt32(*vectorizeWidth))})
+        );
+    }
+
+    if (optional<int> interleaveCount = statementRepeat->getInterleaveCount()) {
+        properties.push_back(
+            llvm::MDNode::get(*context, {llvm::MDString::get(*context, "llvm.loop.interleave.count"), llvm::ConstantAsMetadata::get(builder->getInt32(*interleaveCount))})
+        );
+    }
+
+    if (accessGroup != nullptr)
+        properties.push_back(llvm::MDNode::get(*context, {llvm::MDString::get(*context, "llvm.loop.parallel_accesses"), accessGroup}));
+
+    if (properties.size() == 1)
+        return nullptr;
+
+    llvm::MDNode *loopId = llvm::MDNode::getDistinct(*context, properties);
+    loopId->replaceOperandWith(0, loopId);
+    return loopId;
+}
+
+llvm::MDNode *ModuleBuilder::branchWeightsForLikelihood(optional<bool> isConditionLikely) {
+    if (!isConditionLikely)
+        return nullptr;
+
+    // weights for the true and false side
+    llvm::MDBuilder mdBuilder(*context);
+    if (*isConditionLikely)
+        return mdBuilder.createBranchWeights(LIKELY_BRANCH_WEIGHT, 1);
+    else
+        return mdBuilder.createBranchWeights(1, LIKELY_BRANCH_WEIGHT);
+}
+
+bool ModuleBuilder::isCountedLoop(shared_ptr<StatementRepeat> statementRepeat) {
+    // rep i <- start, i < end, i <- i + step
+    shared_ptr<StatementVariable> initStatement = dynamic_pointer_cast<StatementVariable>(statementRepeat->getInitStatement());
+    shared_ptr<ExpressionBinary> preExpression = dynamic_pointer_cast<ExpressionBinary>(statementRepeat->getPreConditionExpression());
+    shared_ptr<StatementAssignment> postStatement = dynamic_pointer_cast<StatementAssignment>(statementRepeat->getPostStatement());
+    if (initStatement == nullptr || preExpression == nullptr || postStatement == nullptr || statementRepeat->getPostConditionExpression() != nullptr)
+        return false;
+    if (!initStatement->getValueType()->isInteger())
+        return false;
+    string counterName = initStatement->getIdentifier();
+
+    // counter is compared against the end
+    switch (preExpression->getOperation()) {
+        case ExpressionBinaryOperation::LESS:
+        case ExpressionBinaryOperation::LESS_EQUAL:
+        case ExpressionBinaryOperation::GREATER:
+        case ExpressionBinaryOperation::GREATER_EQUAL:
+        case ExpressionBinaryOperation::NOT_EQUAL:
+            break;
+        default:
+            return false;
+    }
+    shared_ptr<ExpressionValue> conditionValue = dynamic_pointer_cast<ExpressionValue>(preExpression->getLeft());
+    if (conditionValue == nullptr || conditionValue->getValueKind() != ExpressionValueKind::SIMPLE || conditionValue->getIdentifier().compare(counterName) != 0)
+        return false;
+
+    // and stepped up or down
+    vector<shared_ptr<Expression>> targetExpressions = postStatement->getExpressionChained()->getChainExpressions();
+    shared_ptr<ExpressionValue> targetValue = targetExpressions.size() == 1 ? dynamic_pointer_cast<ExpressionValue>(targetExpressions.front()) : nullptr;
+    if (targetValue == nullptr || targetValue->getValueKind() != ExpressionValueKind::SIMPLE || targetValue->getIdentifier().compare(counterName) != 0)
+        return false;
+    shared_ptr<ExpressionBinary> stepExpression = dynamic_pointer_cast<ExpressionBinary>(postStatement->getValueExpression());
+    if (stepExpression == nullptr || (stepExpression->getOperation() != ExpressionBinaryOperation::ADD && stepExpression->getOperation() != ExpressionBinaryOperation::SUB))
+        return false;
+    shared_ptr<ExpressionValue> stepValue = dynamic_pointer_cast<ExpressionValue>(stepExpression->getLeft());
+    return stepValue != nullptr && stepValue->getValueKind() == ExpressionValueKind::SIMPLE && stepValue->getIdentifier().compare(counterName) == 0;
+}
+
+llvm::GlobalVariable *ModuleBuilder::constantGlobalForConstant(llvm::Constant *constant) {
+    // constants are uniqued by llvm, so the same values share a global
+    auto it = constantGlobalsMap.find(constant);
+    if (it != constantGlobalsMap.end())
+        return it->second;
+
+    llvm::GlobalVariable *global = new llvm::GlobalVariable(*llvmModule, constant->getType(), true, llvm::GlobalValue::LinkageTypes::PrivateLinkage, constant, "const");
+    global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    global->setAlignment(llvmModule->getDataLayout().getPreferredAlign(global));
+    constantGlobalsMap[constant] = global;
+    return global;
+}
+
+llvm::StructType *ModuleBuilder::vtableTypeForProto(string protoName) {
+    // offsets for variables, pointers for functions, in the order of proto members
+    vector<llvm::Type *> types;
+    for (pair<string, shared_ptr<ValueType>> &member : *scope->getProtoStructMembers(protoName))
+        types.push_back(member.second->getSubType()->isFunction() ? typePtr : typePtrInt);
+    return llvm::StructType::get(*context, types);
+}
+
+llvm::GlobalVariable *ModuleBuilder::vtableForBlobProto(string blobName, string protoName) {
+    // one for each blob and proto pair
+    string vtableName = format("vtable.{}.{}", blobName, protoName);
+    auto it = vtablesMap.find(vtableName);
+    if (it != vtablesMap.end())
+        return it->second;
+
+    llvm::StructType *blobStructType = scope->getStructType(blobName);
+    if (blobStructType == nullptr) {
+        markErrorNotDefined(nullptr, format("blob \"{}\"", blobName));
+        return nullptr;
+    }
+    const llvm::StructLayout *blobLayout = llvmModule->getDataLayout().getStructLayout(blobStructType);
+
+    vector<llvm::Constant *> entries;
+    for (pair<string, shared_ptr<ValueType>> &member : *scope->getProtoStructMembers(protoName)) {
+        if (member.second->getSubType()->isFunction()) {
+            string functionName = format("{}.{}", blobName, member.first);
+            llvm::Function *fun = scope->getFunction(functionName);
+            if (fun == nullptr) {
+                markErrorNotDefined(nullptr, format("function \"{}\"", functionName));
+                return nullptr;
+            }
+            entries.push_back(fun);
+        } else {
+            optional<int> memberIndex = scope->getStructMemberIndex(blobName, member.first);
+            if (!memberIndex) {
+                markErrorNotDefined(nullptr, format("member \"{}\" of blob \"{}\"", member.first, blobName));
+                return nullptr;
+            }
+            entries.push_back(llvm::ConstantInt::get(typePtrInt, blobLayout->getElementOffset(*memberIndex)));
+        }
+    }
+
+    llvm::Constant *vtableConstant = llvm::ConstantStruct::get(vtableTypeForProto(protoName), entries);
+    llvm::GlobalVariable *global = new llvm::GlobalVariable(*llvmModule, vtableConstant->getType(), true, llvm::GlobalValue::LinkageTypes::PrivateLinkage, vtableConstant, vtableName);
+    global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    vtablesMap[vtableName] = global;
+    return global;
+}
+
+void ModuleBuilder::registerGenericBlob(string moduleName, string blobName, shared_ptr<StatementBlob> statementBlob) {
+    // proto conforming blobs are called through the shared vtables, so they stay erased
+    if (blobSpecializations == nullptr || statementBlob->getNamedTypeKeys().empty() || !statementBlob->getProtoNames().empty())
+        return;
+
+    genericBlobsMap[blobName] = pair(moduleName, statementBlob);
+}
+
+void ModuleBuilder::setNamedTypes(string blobName, vector<shared_ptr<ValueType>> typeArguments) {
+    vector<string> namedTypeKeys = genericBlobsMap.at(blobName).second->getNamedTypeKeys();
+
+    namedTypesBlobName = blobName;
+    namedTypesMap.clear();
+    for (int i=0; i<namedTypeKeys.size() && i<typeArguments.size(); i++)
+        namedTypesMap[namedTypeKeys.at(i)] = typeArguments.at(i);
+}
+
+shared_ptr<ValueType> ModuleBuilder::resolvedNamedType(shared_ptr<ValueType> valueType) {
+    if (valueType == nullptr || !valueType->isNamedType())
+        return valueType;
+
+    auto it = namedTypesMap.find(*valueType->getNamedTypeKey());
+    if (it == namedTypesMap.end())
+        return nullptr;
+    return it->second;
+}
+
+shared_ptr<ValueType> ModuleBuilder::specializedUnboxedType(shared_ptr<ValueType> valueType) {
+    if (blobSpecializations == nullptr || valueType == nullptr || !valueType->isBoxed())
+        return nullptr;
+
+    // only types which can be boxed
+    shared_ptr<ValueType> unboxedType = resolvedNamedType(valueType->getSubType());
+    if (!BlobSpecializations::mangledName(unboxedType))
+        return nullptr;
+    return unboxedType;
+}
+
+optional<vector<shared_ptr<ValueType>>> ModuleBuilder::specializedTypeArguments(shared_ptr<ValueType> blobValueType) {
+    if (blobSpecializations == nullptr || blobValueType == nullptr || !blobValueType->isBlob())
+        return {};
+
+    string blobName = *blobValueType->getBlobName();
+    auto it = genericBlobsMap.find(blobName);
+    if (it == genericBlobsMap.end())
+        return {};
+    vector<string> namedTypeKeys = it->second.second->getNamedTypeKeys();
+
+    vector<shared_ptr<ValueType>> typeArguments;
+    optional<vector<shared_ptr<ValueType>>> namedTypeValues = blobValueType->getNamedTypeValues();
+    if (namedTypeValues && !namedTypeValues->empty()) {
+        for (shared_ptr<ValueType> &namedTypeValue : *namedTypeValues)
+            typeArguments.push_back(resolvedNamedType(namedTypeValue));
+    // blob's own `it` doesn't carry the type arguments
+    } else if (blobName.compare(namedTypesBlobName) == 0) {
+        for (string &namedTypeKey : namedTypeKeys)
+            typeArguments.push_back(resolvedNamedType(ValueType::namedType(namedTypeKey)));
+    } else {
+        return {};
+    }
+
+    if (typeArguments.size() != namedTypeKeys.size() || !BlobSpecializations::specializedName(blobName, typeArguments))
+        return {};
+
+    // only the collected copies get built by the defining module, others use the shared one
+    string qualifiedBlobName = format("{}.{}", it->second.first, it->second.second->getName());
+    if (!blobSpecializations->hasTypeArguments(qualifiedBlobName, typeArguments))
+        return {};
+    return typeArguments;
+}
+
+llvm::StructType *ModuleBuilder::specializedStructType(string blobName, vector<shared_ptr<ValueType>> typeArguments) {
+    string specializedBlobName = *BlobSpecializations::specializedName(blobName, typeArguments);
+    auto it = specializedStructTypesMap.find(specializedBlobName);
+    if (it != specializedStructTypesMap.end())
+        return it->second;
+
+    string moduleName = genericBlobsMap.at(blobName).first;
+    shared_ptr<StatementBlob> statementBlob = genericBlobsMap.at(blobName).second;
+
+    // symbol name
+    string symbolName = statementBlob->getName();
+    if (!moduleName.empty() && moduleName.compare(defaultModuleName) != 0)
+        symbolName = format("{}.{}", moduleName, symbolName);
+
+    llvm::StructType *structType = llvm::StructType::create(*context, *BlobSpecializations::specializedName(symbolName, typeArguments));
+    specializedStructTypesMap[specializedBlobName] = structType;
+
+    // member types with the type arguments in place
+    string outerNamedTypesBlobName = namedTypesBlobName;
+    map<string, shared_ptr<ValueType>> outerNamedTypesMap = namedTypesMap;
+    setNamedTypes(blobName, typeArguments);
+
+    vector<llvm::Type *> types;
+    for (pair<string, shared_ptr<ValueType>> &member : statementBlob->getMembers()) {
+        llvm::Type *type = llvmTypeForValueType(member.second);
+        if (type == nullptr)
+            break;
+        types.push_back(type);
+    }
+
+    namedTypesBlobName = outerNamedTypesBlobName;
+    namedTypesMap = outerNamedTypesMap;
+
+    if (types.size() != statementBlob->getMembers().size())
+        return nullptr;
+    structType->setBody(types, false);
+    return structType;
+}
+
+llvm::Function *ModuleBuilder::specializedFunction(shared_ptr<ValueType> blobValueType, string memberName) {
+    optional<vector<shared_ptr<ValueType>>> typeArguments = specializedTypeArguments(blobValueType);
+    if (!typeArguments)
+        return nullptr;
+
+    return specializedFunction(*blobValueType->getBlobName(), *typeArguments, memberName);
+}
+
+llvm::Function *ModuleBuilder::specializedFunction(string blobName, vector<shared_ptr<ValueType>> typeArguments, string memberName) {
+    string functionName = format("{}.{}", *BlobSpecializations::specializedName(blobName, typeArguments), memberName);
+    auto it = specializedFunctionsMap.find(functionName);
+    if (it != specializedFunctionsMap.end())
+        return it->second;
+
+    auto declarationIt = genericFunctionDeclarationsMap.find(format("{}.{}", blobName, memberName));
+    if (declarationIt == genericFunctionDeclarationsMap.end())
+        return nullptr;
+    shared_ptr<StatementFunctionDeclaration> statementDeclaration = declarationIt->second;
+
+    string moduleName = genericBlobsMap.at(blobName).first;
+    shared_ptr<StatementBlob> statementBlob = genericBlobsMap.at(blobName).second;
+    bool isLocal = moduleName.compare(module->getName()) == 0;
+
+    // declare it with the type arguments in place
+    string outerNamedTypesBlobName = namedTypesBlobName;
+    map<string, shared_ptr<ValueType>> outerNamedTypesMap = namedTypesMap;
+    setNamedTypes(blobName, typeArguments);
+
+    buildFunctionDeclaration(
+        moduleName,
+        format("{}.{}", *BlobSpecializations::specializedName(statementBlob->getName(), typeArguments), memberName),
+        !isLocal || statementBlob->getShouldExport(),
+        statementDeclaration->getArguments(),
+        statementDeclaration->getReturnValueType(),
+        statementDeclaration
+    );
+
+    namedTypesBlobName = outerNamedTypesBlobName;
+    namedTypesMap = outerNamedTypesMap;
+
+    llvm::Function *fun = scope->getFunction(functionName);
+    specializedFunctionsMap[functionName] = fun;
+    if (fun == nullptr)
+        return nullptr;
+
+    // only the defining module has the body, others call it by symbol
+    if (isLocal) {
+        for (shared_ptr<StatementFunction> &statementFunction : statementBlob->getFunctionStatements()) {
+            if (statementFunction->getName().compare(statementDeclaration->getName()) == 0)
+                pendingSpecializedFunctions.push_back({statementFunction, fun, blobName, typeArguments});
+        }
+    }
+
+    return fun;
+}
+
+llvm::Value *ModuleBuilder::coercedBoxedValue(llvm::Value *value, llvm::Type *type) {
+    llvm::Type *sourceType = value->getType();
+    bool isSourceScalar = sourceType->isIntegerTy() || sourceType->isFloatingPointTy() || sourceType->isPointerTy();
+    bool isTargetScalar = type->isIntegerTy() || type->isFloatingPointTy() || type->isPointerTy();
+    if (sourceType == type || !isSourceScalar || !isTargetScalar)
+        return value;
+
+    // go through integers, so the bits are kept as they are
+    llvm::Type *sourceIntType = sourceType->isPointerTy() ? typePtrInt : llvm::Type::getIntNTy(*context, sourceType->getPrimitiveSizeInBits().getFixedValue());
+    llvm::Type *targetIntType = type->isPointerTy() ? typePtrInt : llvm::Type::getIntNTy(*context, type->getPrimitiveSizeInBits().getFixedValue());
+    llvm::Value *intValue = builder->CreateBitOrPointerCast(value, sourceIntType);
+    intValue = builder->CreateZExtOrTrunc(intValue, targetIntType);
+    return builder->CreateBitOrPointerCast(intValue, type);
+}
+
+llvm::MDNode *ModuleBuilder::tbaaTypeForType(llvm::Type *type) {
+    if (tbaaRoot == nullptr || type == nullptr)
+        return nullptr;
+
+    // data is described by its elements
+    if (llvm::ArrayType *arrayType = llvm::dyn_cast<llvm::ArrayType>(type))
+        return tbaaTypeForType(arrayType->getElementType());
+
+    // vectors are also accessed lane by lane
+    if (type->isVectorTy())
+        return tbaaAnyType;
+
+    // blobs by their members and offsets
+    if (llvm::StructType *structType = llvm::dyn_cast<llvm::StructType>(type)) {
+        auto it = tbaaStructTypesMap.find(structType);
+        if (it != tbaaStructTypesMap.end())
+            return it->second;
+        if (structType->isOpaque())
+            return nullptr;
+
+        const llvm::StructLayout *structLayout = llvmModule->getDataLayout().getStructLayout(structType);
+        vector<pair<llvm::MDNode *, uint64_t>> fields;
+        for (int i=0; i<structType->getNumElements(); i++) {
+            llvm::MDNode *fieldType = tbaaTypeForType(structType->getElementType(i));
+            if (fieldType == nullptr)
+                return nullptr;
+            fields.push_back(pair(fieldType, structLayout->getElementOffset(i)));
+        }
+        string name = structType->hasName() ? string(structType->getName()) : "blob";
+        llvm::MDNode *structNode = llvm::MDBuilder(*context).createTBAAStructTypeNode(name, fields);
+        tbaaStructTypesMap[structType] = structNode;
+        return structNode;
+    }
+
+    // bytes are used to access raw memory
+    if (type->isIntegerTy(8))
+        return tbaaAnyType;
+
+    // signedness doesn't matter, so scalars are named after the type they are lowered to
+    string name;
+    if (type->isIntegerTy())
+        name = format("i{}", type->getIntegerBitWidth());
+    else if (type->isFloatTy())
+        name = "f32";
+    else if (type->isDoubleTy())
+        name = "f64";
+    else if (type->isPointerTy())
+        name = "ptr";
+    else
+        return nullptr;
+
+    auto it = tbaaScalarTypesMap.find(name);
+    if (it != tbaaScalarTypesMap.end())
+        return it->second;
+    llvm::MDNode *scalarNode = llvm::MDBuilder(*context).createTBAAScalarTypeNode(name, tbaaAnyType);
+    tbaaScalarTypesMap[name] = scalarNode;
+    return scalarNode;
+}
+
+llvm::MDNode *ModuleBuilder::tbaaAccessTagForValueType(shared_ptr<ValueType> valueType) {
+    if (tbaaRoot == nullptr || valueType == nullptr)
+        return nullptr;
+
+    llvm::MDNode *typeNode = nullptr;
+    switch (valueType->getKind()) {
+        case ValueTypeKind::BOOL:
+        case ValueTypeKind::UINT:
+        case ValueTypeKind::U8:
+        case ValueTypeKind::U16:
+        case ValueTypeKind::U32:
+        case ValueTypeKind::U64:
+        case ValueTypeKind::SINT:
+        case ValueTypeKind::S8:
+        case ValueTypeKind::S16:
+        case ValueTypeKind::S32:
+        case ValueTypeKind::S64:
+        case ValueTypeKind::FLOAT:
+        case ValueTypeKind::F32:
+        case ValueTypeKind::F64:
+        case ValueTypeKind::PTR:
+            typeNode = tbaaTypeForType(llvmTypeForValueType(valueType));
+            break;
+        // raw addresses and boxed values may refer to anything
+        case ValueTypeKind::A:
+        case ValueTypeKind::BOXED:
+            typeNode = tbaaAnyType;
+            break;
+        // aggregates are copied as a whole, which touches members of different types
+        default:
+            return nullptr;
+    }
+
+    if (typeNode == nullptr)
+        return nullptr;
+    return llvm::MDBuilder(*context).createTBAAStructTagNode(typeNode, typeNode, 0);
+}
+
+llvm::MDNode *ModuleBuilder::tbaaAccessTagForMember(llvm::StructType *structType, int memberIndex, shared_ptr<ValueType> memberValueType) {
+    llvm::MDNode *accessTag = tbaaAccessTagForValueType(memberValueType);
+    if (accessTag == nullptr)
+        return nullptr;
+
+    // members which may alias anything are not tied to their blob
+    llvm::MDNode *accessType = llvm::dyn_cast<llvm::MDNode>(accessTag->getOperand(1));
+    if (accessType == tbaaAnyType)
+        return accessTag;
+
+    // member accessed as a different type than it's stored in (for example an erased boxed value)
+    llvm::MDBuilder mdBuilder(*context);
+    if (tbaaTypeForType(structType->getElementType(memberIndex)) != accessType)
+        return mdBuilder.createTBAAStructTagNode(tbaaAnyType, tbaaAnyType, 0);
+
+    // otherwise the offset tells apart members of the same type
+    llvm::MDNode *baseType = tbaaTypeForType(structType);
+    if (baseType == nullptr)
+        return accessTag;
+    uint64_t offset = llvmModule->getDataLayout().getStructLayout(structType)->getElementOffset(memberIndex);
+    return mdBuilder.createTBAAStructTagNode(baseType, accessType, offset);
+}
+
 //
 // Error Handling
 //
@@ -4,12 +4,16 @@
 #include <format>
 #include <map>
 #include <ranges>
+#include <set>
 #include <stack>
+#include <tuple>
 
+#include <llvm/Analysis/VectorUtils.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/InlineAsm.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/raw_ostream.h>
@@ -18,9 +22,11 @@
 
 #include "Scope.h"
 
+class BlobSpecializations;
 class Error;
 class Location;
 class Module;
+class ModuleReachability;
 class ValueType;
 class WrappedValue;
 
@@ -60,6 +66,16 @@ class ExpressionValue;
 enum class ExpressionBinaryOperation;
 enum class ExpressionUnaryOperation;
 
+// aggregates initialized from literals at least this big (in bytes) are copied from a constant
+#define MIN_CONSTANT_COPY_SIZE 32
+// aggregates at least this big (in bytes) are copied with memcpy instead of a load and store,
+// and passed to or returned from functions through a pointer
+#define MIN_AGGREGATE_COPY_SIZE 32
+// whole data operations and reductions are done on vectors of this many bits at a time
+#define DATA_CHUNK_SIZE 256
+// weight of the expected side of a branch marked with @likely or @unlikely, the other side gets 1
+#define LIKELY_BRANCH_WEIGHT 2000
+
 using namespace std;
 
 class ModuleBuilder {
@@ -69,6 +85,33 @@ private:
 
     shared_ptr<Module> module;
     map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap;
+    set<string> importedModuleNames;
+    map<llvm::Constant *, llvm::GlobalVariable *> constantGlobalsMap;
+    map<string, llvm::GlobalVariable *> vtablesMap;
+    // arguments which are passed as a pointer to the caller's value or to its copy
+    map<llvm::Function *, vector<bool>> funArgumentsPassedByPointerMap;
+    shared_ptr<ModuleReachability> reachability;
+    // integer overflow wraps around instead of being undefined
+    bool isWrapping;
+
+    // for specializing generic blobs
+    shared_ptr<BlobSpecializations> blobSpecializations;
+    map<string, pair<string, shared_ptr<StatementBlob>>> genericBlobsMap;
+    map<string, shared_ptr<StatementFunctionDeclaration>> genericFunctionDeclarationsMap;
+    map<string, llvm::StructType *> specializedStructTypesMap;
+    map<string, llvm::Function *> specializedFunctionsMap;
+    vector<tuple<shared_ptr<StatementFunction>, llvm::Function *, string, vector<shared_ptr<ValueType>>>> pendingSpecializedFunctions;
+    string namedTypesBlobName;
+    map<string, shared_ptr<ValueType>> namedTypesMap;
+
+    // exported bodies of the imported functions, which can be inlined
+    vector<tuple<string, shared_ptr<StatementFunction>, llvm::Function *>> importedInlineFunctions;
+
+    // type-based alias analysis
+    llvm::MDNode *tbaaRoot = nullptr;
+    llvm::MDNode *tbaaAnyType = nullptr;
+    map<string, llvm::MDNode *> tbaaScalarTypesMap;
+    map<llvm::StructType *, llvm::MDNode *> tbaaStructTypesMap;
 
     shared_ptr<Scope> scope;
 
@@ -104,6 +147,7 @@ private:
     void buildStatement(shared_ptr<StatementBlock> statementBlock);
     void buildStatement(shared_ptr<StatementExpression> statementExpression);
     void buildStatement(shared_ptr<StatementFunction> statementFunction);
+    void buildFunctionBody(shared_ptr<StatementFunction> statementFunction, llvm::Function *fun);
     void buildStatement(shared_ptr<StatementFunctionDeclaration> statementFunctionDeclaration);
     void buildStatement(shared_ptr<StatementMetaExternFunction> statementMetaExternFunction);
     void buildStatement(shared_ptr<StatementMetaExternVariable> statementMetaExternVariable);
@@ -116,18 +160,26 @@ private:
     void buildStatement(shared_ptr<StatementVariable> statementVariable);
     void buildStatement(shared_ptr<StatementVariableDeclaration> statementVariableDeclaration);
 
-    void buildFunctionDeclaration(string moduleName, string name, bool isExtern, vector<pair<string, shared_ptr<ValueType>>> arguments, shared_ptr<ValueType> returnType);
+    void buildFunctionDeclaration(string moduleName, string name, bool isExtern, vector<pair<string, shared_ptr<ValueType>>> arguments, shared_ptr<ValueType> returnType, shared_ptr<StatementFunctionDeclaration> attributesStatement = nullptr);
+    void buildFunctionAttributes(llvm::Function *fun, shared_ptr<StatementFunctionDeclaration> attributesStatement);
     void buildRawFunction(string moduleName, shared_ptr<StatementRawFunction> statement);
-    void buildVariableDeclaration(string moduleName, string name, bool isExtern, shared_ptr<ValueType> valueType);
+    void buildVariableDeclaration(string moduleName, string name, bool isExtern, shared_ptr<ValueType> valueType, bool isConstant = false, shared_ptr<StatementVariable> constantStatement = nullptr);
 
     void buildProtoDeclaration(string moduleName, shared_ptr<StatementProtoDeclaration> statement);
     void buildProtoDefinition(string moduleName, shared_ptr<StatementProto> statement);
 
     void buildBlobDeclaration(string moduleName, string name);
     void buildBlobDefinition(string moduleName, string name, vector<pair<string, shared_ptr<ValueType>>> members);
+    void buildSpecializedFunctions();
+    void buildImportedInlineFunctions();
+    void setImportedAliases(string moduleName);
     void buildLocalVariable(shared_ptr<StatementVariable> statement);
     void buildGlobalVariable(shared_ptr<StatementVariable> statement);
-    void buildAssignment(shared_ptr<WrappedValue> targetWrappedValue, shared_ptr<Expression> valueExpression);
+    void buildAssignment(shared_ptr<WrappedValue> targetWrappedValue, shared_ptr<Expression> valueExpression, bool isInitialization = false);
+    bool buildConstantCopy(shared_ptr<WrappedValue> targetWrappedValue, shared_ptr<ExpressionCompositeLiteral> expressionCompositeLiteral, bool isInitialization);
+    llvm::AllocaInst *buildLocalAlloca(llvm::Type *type, string name);
+    void buildLifetimesEnd();
+    void buildDataChunks(int elementsCount, int chunkLanesCount, function<void(llvm::Value *, int)> buildChunk);
 
     // Expressions
     shared_ptr<WrappedValue> wrappedValueForExpression(shared_ptr<Expression> expression);
@@ -143,14 +195,46 @@ private:
     shared_ptr<WrappedValue> wrappedValueForExpression(shared_ptr<ExpressionValue> expressionValue);
 
     shared_ptr<WrappedValue> wrappedValueForBuiltIn(shared_ptr<WrappedValue> parentWrappedValue, shared_ptr<Expression> parentExpression, shared_ptr<Expression> expression);
-    shared_ptr<WrappedValue> wrappedValueForCall(llvm::Value *callee, llvm::FunctionType *funType, vector<llvm::Value*> implicitArguments, vector<shared_ptr<Expression>> argumentExpressions, shared_ptr<ValueType> valueType);
+    shared_ptr<WrappedValue> wrappedValueForIntrinsic(shared_ptr<WrappedValue> parentWrappedValue, shared_ptr<Expression> parentExpression, shared_ptr<Expression> expression);
+    shared_ptr<WrappedValue> wrappedValueForMemoryHint(shared_ptr<WrappedValue> parentWrappedValue, shared_ptr<Expression> parentExpression, shared_ptr<ExpressionCall> expressionCall);
+    shared_ptr<WrappedValue> wrappedValueForReduction(shared_ptr<WrappedValue> parentWrappedValue, shared_ptr<Expression> parentExpression, shared_ptr<ExpressionValue> expressionValue);
+    shared_ptr<WrappedValue> wrappedValueForDataOperation(shared_ptr<ExpressionBinary> expressionBinary, shared_ptr<WrappedValue> leftWrappedValue, shared_ptr<WrappedValue> rightWrappedValue);
+    shared_ptr<WrappedValue> wrappedValueForCall(llvm::Value *callee, llvm::FunctionType *funType, llvm::AttributeList funAttributes, vector<bool> argumentsPassedByPointer, vector<llvm::Value*> implicitArguments, vector<shared_ptr<Expression>> argumentExpressions, shared_ptr<ValueType> valueType);
     shared_ptr<WrappedValue> wrappedValueForCast(shared_ptr<WrappedValue> wrappedValue, shared_ptr<ValueType> targetValueType);
-    shared_ptr<WrappedValue> wrappedValueForValue(llvm::Value *value, llvm::Value *pointerValue, llvm::Type *type, shared_ptr<Expression> expression);
+    shared_ptr<WrappedValue> wrappedValueForValue(llvm::Value *value, llvm::Value *pointerValue, llvm::Type *type, shared_ptr<Expression> expression, llvm::MDNode *tbaaAccessTag = nullptr);
     shared_ptr<WrappedValue> wrappedValueForTypeBuiltIn(llvm::Type *type, shared_ptr<ExpressionValue> expression);
 
     // Support
     llvm::Type *llvmTypeForValueType(shared_ptr<ValueType> valueType, bool shouldUnbox = false, shared_ptr<Location> location = nullptr);
     int sizeInBitsForType(llvm::Type *type);
+    int sizeInBytesForType(llvm::Type *type);
+    llvm::Align alignForType(llvm::Type *type);
+    llvm::Value *valueForBinaryOperation(ExpressionBinaryOperation operation, shared_ptr<ValueType> valueType, llvm::Value *leftValue, llvm::Value *rightValue);
+    llvm::FunctionType *funTypeForSignature(vector<shared_ptr<ValueType>> argumentTypes, shared_ptr<ValueType> returnType, bool isForeign);
+    llvm::AttributeList funAttributesForSignature(vector<shared_ptr<ValueType>> argumentTypes, shared_ptr<ValueType> returnType);
+    bool isPassedByPointer(llvm::Type *type);
+    bool isPointerContainedInType(llvm::Type *type);
+    vector<bool> argumentsPassedByPointerForSignature(vector<shared_ptr<ValueType>> argumentTypes, bool isForeign);
+    llvm::Constant *constantForExpression(shared_ptr<Expression> expression, llvm::Type *type);
+    bool isConstantExpression(shared_ptr<Expression> expression);
+    bool isCountedLoop(shared_ptr<StatementRepeat> statementRepeat);
+    llvm::GlobalVariable *constantGlobalForConstant(llvm::Constant *constant);
+    llvm::StructType *vtableTypeForProto(string protoName);
+    llvm::GlobalVariable *vtableForBlobProto(string blobName, string protoName);
+    void registerGenericBlob(string moduleName, string blobName, shared_ptr<StatementBlob> statementBlob);
+    void setNamedTypes(string blobName, vector<shared_ptr<ValueType>> typeArguments);
+    shared_ptr<ValueType> resolvedNamedType(shared_ptr<ValueType> valueType);
+    shared_ptr<ValueType> specializedUnboxedType(shared_ptr<ValueType> valueType);
+    optional<vector<shared_ptr<ValueType>>> specializedTypeArguments(shared_ptr<ValueType> blobValueType);
+    llvm::StructType *specializedStructType(string blobName, vector<shared_ptr<ValueType>> typeArguments);
+    llvm::Function *specializedFunction(shared_ptr<ValueType> blobValueType, string memberName);
+    llvm::Function *specializedFunction(string blobName, vector<shared_ptr<ValueType>> typeArguments, string memberName);
+    llvm::Value *coercedBoxedValue(llvm::Value *value, llvm::Type *type);
+    llvm::MDNode *tbaaTypeForType(llvm::Type *type);
+    llvm::MDNode *tbaaAccessTagForValueType(shared_ptr<ValueType> valueType);
+    llvm::MDNode *tbaaAccessTagForMember(llvm::StructType *structType, int memberIndex, shared_ptr<ValueType> memberValueType);
+    llvm::MDNode *loopMetadataForStatementRepeat(shared_ptr<StatementRepeat> statementRepeat, llvm::MDNode *accessGroup);
+    llvm::MDNode *branchWeightsForLikelihood(optional<bool> isConditionLikely);
 
     // Error Handling    
     void markFunctionError(string name, string message);
@@ -184,8 +268,13 @@ public:
         int pointerSize,
         llvm::Triple::ArchType archType,
         llvm::CallingConv::ID callingConvention,
+        llvm::DataLayout dataLayout,
         shared_ptr<Module> module,
-        map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap
+        map<string, vector<shared_ptr<Statement>>> importableHeaderStatementsMap,
+        shared_ptr<ModuleReachability> reachability,
+        shared_ptr<BlobSpecializations> blobSpecializations,
+        bool isTbaaEnabled,
+        bool isWrapping
     );
     shared_ptr<llvm::Module> getLlvmModule();
 };
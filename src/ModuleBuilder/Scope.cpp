@@ -33,6 +33,14 @@ shared_ptr<WrappedValue> Scope::getWrappedValue(string identifier) {
     return nullptr;
 }
 
+void Scope::addAlloca(llvm::AllocaInst *alloca) {
+    scopeLevels.top().allocas.push_back(alloca);
+}
+
+vector<llvm::AllocaInst*> Scope::getAllocas() {
+    return scopeLevels.top().allocas;
+}
+
 bool Scope::setFunction(string name, llvm::Function *function) {
     if (scopeLevels.top().funMap[name] != nullptr)
         return false;
@@ -25,6 +25,8 @@ private:
 
         map<string, llvm::StructType*> structTypeMap;
         map<string, vector<string>> structMembersMap;
+
+        vector<llvm::AllocaInst*> allocas;
     } ScopeLevel;
 
     stack<ScopeLevel> scopeLevels;
@@ -38,6 +40,9 @@ public:
     bool setWrappedValue(string identifier, shared_ptr<WrappedValue> wrappedvalue);
     shared_ptr<WrappedValue> getWrappedValue(string identifier);
 
+    void addAlloca(llvm::AllocaInst *alloca);
+    vector<llvm::AllocaInst*> getAllocas();
+
     bool setFunction(string name, llvm::Function *fun);
     llvm::Function *getFunction(string name);
 
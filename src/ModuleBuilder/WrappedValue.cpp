@@ -33,9 +33,7 @@ shared_ptr<WrappedValue> WrappedValue::wrappedValue(llvm::Value *value, shared_p
     // Alloca
     } else if (llvm::AllocaInst *allocaInst = llvm::dyn_cast<llvm::AllocaInst>(value)) {
         wrappedValue->valueLambda = [type, allocaInst, valueType]() {
-            llvm::LoadInst *load = WrappedValue::builder.lock()->CreateLoad(type, allocaInst, format("ld_wrp-{}", string(allocaInst->getName())));
-            load->setVolatile(true);
-            return load;
+            return WrappedValue::builder.lock()->CreateLoad(type, allocaInst, format("ld_wrp-{}", string(allocaInst->getName())));
         };
         wrappedValue->pointerValueLambda = [allocaInst]() { 
             return allocaInst;
@@ -118,16 +116,26 @@ shared_ptr<WrappedValue> WrappedValue::wrappedValue(llvm::Value *value, shared_p
     return wrappedValue;
 }
 
-shared_ptr<WrappedValue> WrappedValue::wrappedPointerValue(llvm::Value *pointerValue, llvm::Type *type, shared_ptr<ValueType> valueType) {
+shared_ptr<WrappedValue> WrappedValue::wrappedPointerValue(llvm::Value *pointerValue, llvm::Type *type, shared_ptr<ValueType> valueType, llvm::MDNode *tbaaAccessTag, bool isVolatile) {
     shared_ptr<WrappedValue> wrappedValue = make_shared<WrappedValue>();
 
     llvm::Type *pointeeType = WrappedValue::llvmTypeForValueType(valueType, true);
     wrappedValue->type = pointeeType;
     wrappedValue->valueType = valueType;
+    wrappedValue->tbaaAccessTag = tbaaAccessTag;
+    // only memory accessed with .vol is loaded every time, for example memory mapped registers
+    wrappedValue->isVolatile = isVolatile;
 
-    wrappedValue->valueLambda = [pointeeType, pointerValue, valueType]() {
+    bool isLocal = llvm::isa<llvm::AllocaInst>(pointerValue->stripInBoundsOffsets());
+
+    wrappedValue->valueLambda = [pointeeType, pointerValue, valueType, tbaaAccessTag, isVolatile, isLocal]() {
         llvm::LoadInst *load = WrappedValue::builder.lock()->CreateLoad(pointeeType, pointerValue, format("ld_wrp-{}", string(pointerValue->getName())));
-        load->setVolatile(true);
+        load->setVolatile(isVolatile);
+        // vectors behind a pointer are only guaranteed to be aligned as their lanes
+        if (!isLocal && pointeeType->isVectorTy())
+            load->setAlignment(WrappedValue::llvmModule.lock()->getDataLayout().getABITypeAlign(pointeeType->getScalarType()));
+        if (tbaaAccessTag != nullptr)
+            load->setMetadata(llvm::LLVMContext::MD_tbaa, tbaaAccessTag);
         return load;
     };
     wrappedValue->pointerValueLambda = [pointerValue]() {
@@ -200,6 +208,14 @@ shared_ptr<ValueType> WrappedValue::getValueType() {
     return valueType;
 }
 
+llvm::MDNode *WrappedValue::getTbaaAccessTag() {
+    return tbaaAccessTag;
+}
+
+bool WrappedValue::getIsVolatile() {
+    return isVolatile;
+}
+
 bool WrappedValue::isArray() {
     return valueType->isData();
 }
@@ -20,6 +20,8 @@ private:
 
     llvm::Type *type;
     shared_ptr<ValueType> valueType;
+    llvm::MDNode *tbaaAccessTag = nullptr;
+    bool isVolatile = false;
 
     function<llvm::Value *()> valueLambda;
     function<llvm::Value *()> pointerValueLambda;
@@ -30,7 +32,7 @@ public:
     static void setup(weak_ptr<llvm::Module> llvmModule, weak_ptr<llvm::IRBuilder<>> builder, function<llvm::Type *(shared_ptr<ValueType>, bool)> llvmTypeForValueType);
 
     static shared_ptr<WrappedValue> wrappedValue(llvm::Value *value, shared_ptr<ValueType> valueType);
-    static shared_ptr<WrappedValue> wrappedPointerValue(llvm::Value *pointerValue, llvm::Type *pointeeType, shared_ptr<ValueType> valueType);
+    static shared_ptr<WrappedValue> wrappedPointerValue(llvm::Value *pointerValue, llvm::Type *pointeeType, shared_ptr<ValueType> valueType, llvm::MDNode *tbaaAccessTag = nullptr, bool isVolatile = false);
     static shared_ptr<WrappedValue> wrappedUIntValue(llvm::Type *type, uint64_t value, shared_ptr<ValueType> valueType);
     static shared_ptr<WrappedValue> wrappedNone(llvm::Type *type, shared_ptr<ValueType> valueType);
 
@@ -44,6 +46,8 @@ public:
     llvm::ArrayType *getArrayType();
     llvm::StructType *getStructType();
     shared_ptr<ValueType> getValueType();
+    llvm::MDNode *getTbaaAccessTag();
+    bool getIsVolatile();
 
     bool isArray();
     bool isPointer();
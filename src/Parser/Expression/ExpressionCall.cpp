@@ -10,3 +10,8 @@ string ExpressionCall::getName() {
 vector<shared_ptr<Expression>> ExpressionCall::getArgumentExpressions() {
     return argumentExpressions;
 }
+
+
+optional<string> ExpressionCall::getDevirtualizedBlobName() {
+    return devirtualizedBlobName;
+}
\ No newline at end of file
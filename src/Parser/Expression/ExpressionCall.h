@@ -9,11 +9,13 @@ friend class Analyzer;
 private:
     string name;
     vector<shared_ptr<Expression>> argumentExpressions;
+    optional<string> devirtualizedBlobName;
 
 public:
     ExpressionCall(string name, vector<shared_ptr<Expression>> argumentExpressions, shared_ptr<Location> location);
     string getName();
     vector<shared_ptr<Expression>> getArgumentExpressions();
+    optional<string> getDevirtualizedBlobName();
 };
 
 #endif
\ No newline at end of file
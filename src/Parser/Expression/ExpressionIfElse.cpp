@@ -1,7 +1,7 @@
 #include "ExpressionIfElse.h"
 
-ExpressionIfElse::ExpressionIfElse(shared_ptr<Expression> conditionExpression, shared_ptr<Expression> thenExpression, shared_ptr<Expression> elseExpression, shared_ptr<Location> location):
-Expression(ExpressionKind::IF_ELSE, nullptr, location), conditionExpression(conditionExpression), thenExpression(thenExpression), elseExpression(elseExpression) { }
+ExpressionIfElse::ExpressionIfElse(shared_ptr<Expression> conditionExpression, shared_ptr<Expression> thenExpression, shared_ptr<Expression> elseExpression, optional<bool> isConditionLikely, shared_ptr<Location> location):
+Expression(ExpressionKind::IF_ELSE, nullptr, location), conditionExpression(conditionExpression), thenExpression(thenExpression), elseExpression(elseExpression), isConditionLikely(isConditionLikely) { }
 
 shared_ptr<Expression> ExpressionIfElse::getConditionExpression() {
     return conditionExpression;
@@ -14,3 +14,8 @@ shared_ptr<Expression> ExpressionIfElse::getThenExpression() {
 shared_ptr<Expression> ExpressionIfElse::getElseExpression() {
     return elseExpression;
 }
+
+
+optional<bool> ExpressionIfElse::getIsConditionLikely() {
+    return isConditionLikely;
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef EXPRESSION_IF_ELSE_H
 #define EXPRESSION_IF_ELSE_H
 
+#include <optional>
+
 #include "Expression.h"
 
 class ExpressionIfElse: public Expression {
@@ -10,12 +12,14 @@ private:
     shared_ptr<Expression> conditionExpression;
     shared_ptr<Expression> thenExpression;
     shared_ptr<Expression> elseExpression;
+    optional<bool> isConditionLikely;
 
 public:
-    ExpressionIfElse(shared_ptr<Expression> conditionExpression, shared_ptr<Expression> thenExpression, shared_ptr<Expression> elseExpression, shared_ptr<Location> location);
+    ExpressionIfElse(shared_ptr<Expression> conditionExpression, shared_ptr<Expression> thenExpression, shared_ptr<Expression> elseExpression, optional<bool> isConditionLikely, shared_ptr<Location> location);
     shared_ptr<Expression> getConditionExpression();
     shared_ptr<Expression> getThenExpression();
     shared_ptr<Expression> getElseExpression();
+    optional<bool> getIsConditionLikely();
 };
 
 #endif
\ No newline at end of file
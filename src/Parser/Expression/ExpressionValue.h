@@ -6,6 +6,8 @@
 enum class ExpressionValueKind {
     BUILT_IN_COUNT,
     BUILT_IN_ADR,
+    BUILT_IN_INTRINSIC,
+    BUILT_IN_REDUCTION,
     BUILT_IN_SIZE,
     BUILT_IN_VADR,
     BUILT_IN_VAL_SIMPLE,
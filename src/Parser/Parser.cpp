@@ -1,5 +1,8 @@
 #include "Parser.h"
 
+#include <atomic>
+#include <thread>
+
 #include "Error.h"
 #include "Logger.h"
 
@@ -39,10 +42,27 @@
 #include "Parsee/ParseeResult.h"
 #include "Parsee/ParseeResultsGroup.h"
 
-Parser::Parser(vector<shared_ptr<Token>> tokens) :
-tokens(tokens) { }
+Parser::Parser(vector<shared_ptr<Token>> tokens, int jobsCount) :
+tokens(tokens), jobsCount(jobsCount) { }
 
 vector<shared_ptr<Statement>> Parser::getStatements() {
+    // large files are split into top-level chunks which are parsed in parallel
+    if (jobsCount > 1) {
+        if (optional<vector<shared_ptr<Statement>>> statements = parallelStatements())
+            return *statements;
+    }
+
+    optional<vector<shared_ptr<Statement>>> statements = tryStatements();
+    if (!statements) {
+        for (shared_ptr<Error> &error : errors)
+            Logger::print(error);
+        exit(1); 
+    }
+
+    return *statements;
+};
+
+optional<vector<shared_ptr<Statement>>> Parser::tryStatements() {
     ParseeResultsGroup resultsGroup = parseeResultsGroupForParsees(
         {
             // Only the first statement can be module declaration
@@ -70,11 +90,8 @@ vector<shared_ptr<Statement>> Parser::getStatements() {
         }
     );
 
-    if (resultsGroup.getKind() == ParseeResultsGroupKind::FAILURE) {
-        for (shared_ptr<Error> &error : errors)
-            Logger::print(error);
-        exit(1); 
-    }
+    if (resultsGroup.getKind() == ParseeResultsGroupKind::FAILURE)
+        return {};
 
     vector<shared_ptr<Statement>> statements;
 
@@ -82,7 +99,62 @@ vector<shared_ptr<Statement>> Parser::getStatements() {
         statements.push_back(parseeResult.getStatement());
 
     return statements;
-};
+}
+
+optional<vector<shared_ptr<Statement>>> Parser::parallelStatements() {
+    // too small to be worth splitting
+    int chunkTokensCount = max((int)tokens.size() / (jobsCount * 4), MIN_CHUNK_TOKENS_COUNT);
+    if (tokens.size() < chunkTokensCount * 2)
+        return {};
+
+    // a top-level statement begins at the first column of a new line,
+    // a wrongly guessed boundary makes one of the chunks fail and we fall back to parsing serially
+    vector<vector<shared_ptr<Token>>> chunks;
+    int chunkStartIndex = 0;
+    for (int i=chunkStartIndex + chunkTokensCount; i<tokens.size() - 1; i++) {
+        bool isLineStart = tokens.at(i-1)->isOfKind({TokenKind::NEW_LINE}) && tokens.at(i)->getLocation()->getColumn() == 0;
+        if (!isLineStart || tokens.at(i)->isOfKind({TokenKind::NEW_LINE, TokenKind::SEMICOLON, TokenKind::M_MODULE}))
+            continue;
+
+        chunks.push_back(vector<shared_ptr<Token>>(tokens.begin() + chunkStartIndex, tokens.begin() + i));
+        chunks.back().push_back(tokens.back());
+        chunkStartIndex = i;
+        i += chunkTokensCount - 1;
+    }
+    chunks.push_back(vector<shared_ptr<Token>>(tokens.begin() + chunkStartIndex, tokens.end()));
+
+    if (chunks.size() < 2)
+        return {};
+
+    vector<optional<vector<shared_ptr<Statement>>>> chunksStatements(chunks.size());
+    atomic<int> nextChunkIndex = 0;
+
+    auto worker = [&]() {
+        int index;
+        while ((index = nextChunkIndex++) < chunks.size()) {
+            Parser chunkParser(chunks.at(index), 1);
+            chunksStatements.at(index) = chunkParser.tryStatements();
+        }
+    };
+
+    int workersCount = min(jobsCount, (int)chunks.size());
+    vector<thread> threads;
+    for (int i=1; i<workersCount; i++)
+        threads.push_back(thread(worker));
+    worker();
+    for (thread &workerThread : threads)
+        workerThread.join();
+
+    // concatenate in the source order
+    vector<shared_ptr<Statement>> statements;
+    for (optional<vector<shared_ptr<Statement>>> &chunkStatements : chunksStatements) {
+        if (!chunkStatements)
+            return {};
+        statements.insert(statements.end(), chunkStatements->begin(), chunkStatements->end());
+    }
+
+    return statements;
+}
 
 //
 // Statements
@@ -283,6 +355,9 @@ shared_ptr<Statement> Parser::matchStatementMetaExternFunction() {
 shared_ptr<Statement> Parser::matchStatementVariable() {
     enum Tag {
         TAG_SHOULD_EXPORT,
+        TAG_IS_CONSTANT,
+        TAG_IS_UNINITIALIZED,
+        TAG_ALIGNMENT,
         TAG_IDENTIFIER,
         TAG_VALUE_TYPE,
         TAG_EXPRESSION
@@ -294,6 +369,19 @@ shared_ptr<Statement> Parser::matchStatementVariable() {
         {
             // export
             Parsee::tokenParsee(TokenKind::M_EXPORT, ParseeLevel::OPTIONAL, true, TAG_SHOULD_EXPORT),
+            // read-only
+            Parsee::tokenParsee(TokenKind::M_CONST, ParseeLevel::OPTIONAL, true, TAG_IS_CONSTANT),
+            // skip initialization
+            Parsee::tokenParsee(TokenKind::M_UNINIT, ParseeLevel::OPTIONAL, true, TAG_IS_UNINITIALIZED),
+            // @align(bytes)
+            Parsee::groupParsee(
+                {
+                    Parsee::tokenParsee(TokenKind::M_ALIGN, ParseeLevel::REQUIRED, false),
+                    Parsee::tokenParsee(TokenKind::LEFT_ROUND_BRACKET, ParseeLevel::CRITICAL, false),
+                    Parsee::tokenParsee(TokenKind::INTEGER_DEC, ParseeLevel::CRITICAL, true, TAG_ALIGNMENT),
+                    Parsee::tokenParsee(TokenKind::RIGHT_ROUND_BRACKET, ParseeLevel::CRITICAL, false)
+                }, ParseeLevel::OPTIONAL, true
+            ),
             // identifier
             Parsee::tokenParsee(TokenKind::IDENTIFIER, ParseeLevel::REQUIRED, true, TAG_IDENTIFIER),
             Parsee::valueTypeParsee(ParseeLevel::REQUIRED, true, TAG_VALUE_TYPE),
@@ -311,6 +399,9 @@ shared_ptr<Statement> Parser::matchStatementVariable() {
         return nullptr;
 
     bool shouldExport = false;
+    bool isConstant = false;
+    bool isUninitialized = false;
+    optional<int> alignment;
     string identifier;
     shared_ptr<ValueType> valueType;
     shared_ptr<Expression> expression;
@@ -321,6 +412,20 @@ shared_ptr<Statement> Parser::matchStatementVariable() {
                 shouldExport =  true;
                 break;
             }
+            case TAG_IS_CONSTANT: {
+                isConstant = true;
+                break;
+            }
+            case TAG_IS_UNINITIALIZED: {
+                isUninitialized = true;
+                break;
+            }
+            case TAG_ALIGNMENT: {
+                string alignmentString = parseeResult.getToken()->getLexme();
+                erase(alignmentString, '_');
+                alignment = stoi(alignmentString);
+                break;
+            }
             case TAG_IDENTIFIER: {
                 identifier = parseeResult.getToken()->getLexme();
                 break;
@@ -336,14 +441,21 @@ shared_ptr<Statement> Parser::matchStatementVariable() {
         }
     }
 
-    return make_shared<StatementVariable>(shouldExport, identifier, valueType, expression, location);
+    return make_shared<StatementVariable>(shouldExport, isConstant, isUninitialized, alignment, identifier, valueType, expression, location);
 }
 
 shared_ptr<Statement> Parser::matchStatementFunction() {
     enum {
         TAG_SHOULD_EXPORT,
+        TAG_SHOULD_INLINE,
+        TAG_IS_NO_INLINE,
+        TAG_IS_HOT,
+        TAG_IS_COLD,
+        TAG_IS_PURE,
         TAG_NAME,
         TAG_ARGUMENT_IDENTIFIER,
+        TAG_ARGUMENT_NOALIAS,
+        TAG_ARGUMENT_REF,
         TAG_ARGUMENT_TYPE,
         TAG_RETURN_TYPE
     };
@@ -354,6 +466,34 @@ shared_ptr<Statement> Parser::matchStatementFunction() {
         {
             // export
             Parsee::tokenParsee(TokenKind::M_EXPORT, ParseeLevel::OPTIONAL, true, TAG_SHOULD_EXPORT),
+            // attributes
+            Parsee::repeatedGroupParsee(
+                {
+                    Parsee::oneOfParsee(
+                        {
+                            // always inlined, body is included in the exported header
+                            {
+                                Parsee::tokenParsee(TokenKind::M_INLINE, ParseeLevel::REQUIRED, true, TAG_SHOULD_INLINE)
+                            },
+                            {
+                                Parsee::tokenParsee(TokenKind::M_NOINLINE, ParseeLevel::REQUIRED, true, TAG_IS_NO_INLINE)
+                            },
+                            // called often or rarely
+                            {
+                                Parsee::tokenParsee(TokenKind::M_HOT, ParseeLevel::REQUIRED, true, TAG_IS_HOT)
+                            },
+                            {
+                                Parsee::tokenParsee(TokenKind::M_COLD, ParseeLevel::REQUIRED, true, TAG_IS_COLD)
+                            },
+                            // no side effects
+                            {
+                                Parsee::tokenParsee(TokenKind::M_PURE, ParseeLevel::REQUIRED, true, TAG_IS_PURE)
+                            }
+                        }, ParseeLevel::REQUIRED, true
+                    ),
+                    Parsee::tokenParsee(TokenKind::NEW_LINE, ParseeLevel::OPTIONAL, false)
+                }, ParseeLevel::OPTIONAL, true
+            ),
             // identifier
             Parsee::tokenParsee(TokenKind::IDENTIFIER, ParseeLevel::REQUIRED, true, TAG_NAME),
             Parsee::tokenParsee(TokenKind::FUNCTION, ParseeLevel::REQUIRED, false),
@@ -364,6 +504,8 @@ shared_ptr<Statement> Parser::matchStatementFunction() {
                     Parsee::tokenParsee(TokenKind::COLON, ParseeLevel::REQUIRED, false),
                     Parsee::tokenParsee(TokenKind::NEW_LINE, ParseeLevel::OPTIONAL, false),
                     Parsee::tokenParsee(TokenKind::IDENTIFIER, ParseeLevel::CRITICAL, true, TAG_ARGUMENT_IDENTIFIER),
+                    Parsee::tokenParsee(TokenKind::M_NOALIAS, ParseeLevel::OPTIONAL, true, TAG_ARGUMENT_NOALIAS),
+                    Parsee::tokenParsee(TokenKind::REF, ParseeLevel::OPTIONAL, true, TAG_ARGUMENT_REF),
                     Parsee::valueTypeParsee(ParseeLevel::CRITICAL, true, TAG_ARGUMENT_TYPE),
                     // additional arguments
                     Parsee::repeatedGroupParsee(
@@ -371,6 +513,8 @@ shared_ptr<Statement> Parser::matchStatementFunction() {
                             Parsee::tokenParsee(TokenKind::COMMA, ParseeLevel::REQUIRED, false),
                             Parsee::tokenParsee(TokenKind::NEW_LINE, ParseeLevel::OPTIONAL, false),
                             Parsee::tokenParsee(TokenKind::IDENTIFIER, ParseeLevel::CRITICAL, true, TAG_ARGUMENT_IDENTIFIER),
+                            Parsee::tokenParsee(TokenKind::M_NOALIAS, ParseeLevel::OPTIONAL, true, TAG_ARGUMENT_NOALIAS),
+                            Parsee::tokenParsee(TokenKind::REF, ParseeLevel::OPTIONAL, true, TAG_ARGUMENT_REF),
                             Parsee::valueTypeParsee(ParseeLevel::CRITICAL, true, TAG_ARGUMENT_TYPE)
                         }, ParseeLevel::OPTIONAL, true
                     )
@@ -393,8 +537,14 @@ shared_ptr<Statement> Parser::matchStatementFunction() {
         return nullptr;
 
     bool shouldExport = false;
+    bool shouldInline = false;
+    bool isNoInline = false;
+    bool isHot = false;
+    bool isCold = false;
+    bool isPure = false;
     string name;
     vector<pair<string, shared_ptr<ValueType>>> arguments;
+    set<string> noAliasArgumentNames;
     shared_ptr<ValueType> returnType = ValueType::NONE;
     shared_ptr<Statement> statementBlock;
 
@@ -405,6 +555,26 @@ shared_ptr<Statement> Parser::matchStatementFunction() {
                 shouldExport = true;
                 break;
             }
+            case TAG_SHOULD_INLINE: {
+                shouldInline = true;
+                break;
+            }
+            case TAG_IS_NO_INLINE: {
+                isNoInline = true;
+                break;
+            }
+            case TAG_IS_HOT: {
+                isHot = true;
+                break;
+            }
+            case TAG_IS_COLD: {
+                isCold = true;
+                break;
+            }
+            case TAG_IS_PURE: {
+                isPure = true;
+                break;
+            }
             case TAG_NAME: {
                 name = parseeResult.getToken()->getLexme();
                 break;
@@ -412,7 +582,18 @@ shared_ptr<Statement> Parser::matchStatementFunction() {
             case TAG_ARGUMENT_IDENTIFIER: {
                 pair<string, shared_ptr<ValueType>> argument;
                 argument.first = parseeResult.getToken()->getLexme();
+                // doesn't overlap with other pointers?
+                if (resultsGroup.getResults().at(i+1).getTag() == TAG_ARGUMENT_NOALIAS) {
+                    noAliasArgumentNames.insert(argument.first);
+                    i++;
+                }
+                // passed by reference?
+                bool isReference = resultsGroup.getResults().at(i+1).getTag() == TAG_ARGUMENT_REF;
+                if (isReference)
+                    i++;
                 argument.second = resultsGroup.getResults().at(++i).getValueType();
+                if (isReference)
+                    argument.second = ValueType::reference(argument.second);
                 arguments.push_back(argument);
                 break;
             }
@@ -434,7 +615,7 @@ shared_ptr<Statement> Parser::matchStatementFunction() {
         return nullptr;
     }
 
-    return make_shared<StatementFunction>(shouldExport, name, arguments, returnType, dynamic_pointer_cast<StatementBlock>(statementBlock), location);
+    return make_shared<StatementFunction>(shouldExport, shouldInline, isNoInline, isHot, isCold, isPure, name, arguments, noAliasArgumentNames, returnType, dynamic_pointer_cast<StatementBlock>(statementBlock), location);
 }
 
 shared_ptr<Statement> Parser::matchStatementFunctionDeclaration() {
@@ -442,6 +623,7 @@ shared_ptr<Statement> Parser::matchStatementFunctionDeclaration() {
         TAG_SHOULD_EXPORT,
         TAG_NAME,
         TAG_ARGUMENT_IDENTIFIER,
+        TAG_ARGUMENT_REF,
         TAG_ARGUMENT_TYPE,
         TAG_RETURN_TYPE
     };
@@ -462,6 +644,7 @@ shared_ptr<Statement> Parser::matchStatementFunctionDeclaration() {
                     Parsee::tokenParsee(TokenKind::COLON, ParseeLevel::REQUIRED, false),
                     Parsee::tokenParsee(TokenKind::NEW_LINE, ParseeLevel::OPTIONAL, false),
                     Parsee::tokenParsee(TokenKind::IDENTIFIER, ParseeLevel::CRITICAL, true, TAG_ARGUMENT_IDENTIFIER),
+                    Parsee::tokenParsee(TokenKind::REF, ParseeLevel::OPTIONAL, true, TAG_ARGUMENT_REF),
                     Parsee::valueTypeParsee(ParseeLevel::CRITICAL, true, TAG_ARGUMENT_TYPE),
                     // additional arguments
                     Parsee::repeatedGroupParsee(
@@ -469,6 +652,7 @@ shared_ptr<Statement> Parser::matchStatementFunctionDeclaration() {
                             Parsee::tokenParsee(TokenKind::COMMA, ParseeLevel::REQUIRED, false),
                             Parsee::tokenParsee(TokenKind::NEW_LINE, ParseeLevel::OPTIONAL, false),
                             Parsee::tokenParsee(TokenKind::IDENTIFIER, ParseeLevel::CRITICAL, true, TAG_ARGUMENT_IDENTIFIER),
+                            Parsee::tokenParsee(TokenKind::REF, ParseeLevel::OPTIONAL, true, TAG_ARGUMENT_REF),
                             Parsee::valueTypeParsee(ParseeLevel::CRITICAL, true, TAG_ARGUMENT_TYPE)
                         }, ParseeLevel::OPTIONAL, true
                     )
@@ -508,7 +692,13 @@ shared_ptr<Statement> Parser::matchStatementFunctionDeclaration() {
             case TAG_ARGUMENT_IDENTIFIER: {
                 pair<string, shared_ptr<ValueType>> argument;
                 argument.first = parseeResult.getToken()->getLexme();
+                // passed by reference?
+                bool isReference = resultsGroup.getResults().at(i+1).getTag() == TAG_ARGUMENT_REF;
+                if (isReference)
+                    i++;
                 argument.second = resultsGroup.getResults().at(++i).getValueType();
+                if (isReference)
+                    argument.second = ValueType::reference(argument.second);
                 arguments.push_back(argument);
                 break;
             }
@@ -519,7 +709,7 @@ shared_ptr<Statement> Parser::matchStatementFunctionDeclaration() {
         }
     }
 
-    return make_shared<StatementFunctionDeclaration>(shouldExport, name, arguments, returnType, location);
+    return make_shared<StatementFunctionDeclaration>(shouldExport, false, false, false, false, false, name, arguments, set<string>(), returnType, location);
 }
 
 shared_ptr<Statement> Parser::matchStatementRawFunction() {
@@ -1030,13 +1220,65 @@ shared_ptr<Statement> Parser::matchStatementRepeat() {
         TAG_STATEMENT_POST,
         TAG_PRE_CONDITION,
         TAG_POST_CONDITION,
-        TAG_STATEMENT_BLOCK
+        TAG_STATEMENT_BLOCK,
+        TAG_UNROLL_COUNT,
+        TAG_NO_UNROLL,
+        TAG_VECTORIZE_WIDTH,
+        TAG_INTERLEAVE_COUNT,
+        TAG_PARALLEL,
+        TAG_LIKELY,
+        TAG_UNLIKELY
     };
 
     shared_ptr<Location> location = tokens.at(currentIndex)->getLocation();
 
     ParseeResultsGroup resultsGroup = parseeResultsGroupForParsees(
         {
+            // optimization hints
+            Parsee::repeatedGroupParsee(
+                {
+                    Parsee::oneOfParsee(
+                        {
+                            // @unroll(count)
+                            {
+                                Parsee::tokenParsee(TokenKind::M_UNROLL, ParseeLevel::REQUIRED, false),
+                                Parsee::tokenParsee(TokenKind::LEFT_ROUND_BRACKET, ParseeLevel::CRITICAL, false),
+                                Parsee::tokenParsee(TokenKind::INTEGER_DEC, ParseeLevel::CRITICAL, true, TAG_UNROLL_COUNT),
+                                Parsee::tokenParsee(TokenKind::RIGHT_ROUND_BRACKET, ParseeLevel::CRITICAL, false)
+                            },
+                            // @nounroll
+                            {
+                                Parsee::tokenParsee(TokenKind::M_NOUNROLL, ParseeLevel::REQUIRED, true, TAG_NO_UNROLL)
+                            },
+                            // @vectorize(width) or @vectorize(width, interleave)
+                            {
+                                Parsee::tokenParsee(TokenKind::M_VECTORIZE, ParseeLevel::REQUIRED, false),
+                                Parsee::tokenParsee(TokenKind::LEFT_ROUND_BRACKET, ParseeLevel::CRITICAL, false),
+                                Parsee::tokenParsee(TokenKind::INTEGER_DEC, ParseeLevel::CRITICAL, true, TAG_VECTORIZE_WIDTH),
+                                Parsee::groupParsee(
+                                    {
+                                        Parsee::tokenParsee(TokenKind::COMMA, ParseeLevel::REQUIRED, false),
+                                        Parsee::tokenParsee(TokenKind::INTEGER_DEC, ParseeLevel::CRITICAL, true, TAG_INTERLEAVE_COUNT)
+                                    }, ParseeLevel::OPTIONAL, true
+                                ),
+                                Parsee::tokenParsee(TokenKind::RIGHT_ROUND_BRACKET, ParseeLevel::CRITICAL, false)
+                            },
+                            // @parallel
+                            {
+                                Parsee::tokenParsee(TokenKind::M_PARALLEL, ParseeLevel::REQUIRED, true, TAG_PARALLEL)
+                            },
+                            // @likely or @unlikely
+                            {
+                                Parsee::tokenParsee(TokenKind::M_LIKELY, ParseeLevel::REQUIRED, true, TAG_LIKELY)
+                            },
+                            {
+                                Parsee::tokenParsee(TokenKind::M_UNLIKELY, ParseeLevel::REQUIRED, true, TAG_UNLIKELY)
+                            }
+                        }, ParseeLevel::REQUIRED, true
+                    ),
+                    Parsee::tokenParsee(TokenKind::NEW_LINE, ParseeLevel::OPTIONAL, false)
+                }, ParseeLevel::OPTIONAL, true
+            ),
             Parsee::tokenParsee(TokenKind::REPEAT, ParseeLevel::REQUIRED, false),
             Parsee::oneOfParsee(
                 {
@@ -1123,9 +1365,43 @@ shared_ptr<Statement> Parser::matchStatementRepeat() {
     shared_ptr<Expression> preConditionExpression;
     shared_ptr<Expression> postConditionExpression;
     shared_ptr<Statement> bodyBlockStatement;
+    // hint values are decimal integers, which may contain separators
+    auto hintValueForToken = [](shared_ptr<Token> token) {
+        string valueString = token->getLexme();
+        erase(valueString, '_');
+        return stoi(valueString);
+    };
+
+    optional<int> unrollCount;
+    bool isNoUnroll = false;
+    optional<int> vectorizeWidth;
+    optional<int> interleaveCount;
+    bool isParallel = false;
+    optional<bool> isConditionLikely;
 
     for (ParseeResult &parseeResult : resultsGroup.getResults()) {
         switch (parseeResult.getTag()) {
+            case TAG_UNROLL_COUNT:
+                unrollCount = hintValueForToken(parseeResult.getToken());
+                break;
+            case TAG_NO_UNROLL:
+                isNoUnroll = true;
+                break;
+            case TAG_VECTORIZE_WIDTH:
+                vectorizeWidth = hintValueForToken(parseeResult.getToken());
+                break;
+            case TAG_INTERLEAVE_COUNT:
+                interleaveCount = hintValueForToken(parseeResult.getToken());
+                break;
+            case TAG_PARALLEL:
+                isParallel = true;
+                break;
+            case TAG_LIKELY:
+                isConditionLikely = true;
+                break;
+            case TAG_UNLIKELY:
+                isConditionLikely = false;
+                break;
             case TAG_STATEMENT_INIT:
                 initStatement = parseeResult.getStatement();
                 break;
@@ -1150,6 +1426,12 @@ shared_ptr<Statement> Parser::matchStatementRepeat() {
         preConditionExpression,
         postConditionExpression,
         dynamic_pointer_cast<StatementBlock>(bodyBlockStatement),
+        unrollCount,
+        isNoUnroll,
+        vectorizeWidth,
+        interleaveCount,
+        isParallel,
+        isConditionLikely,
         location
     );
 }
@@ -1632,6 +1914,8 @@ shared_ptr<Expression> Parser::matchExpressionCast() {
 
 shared_ptr<Expression> Parser::matchExpressionIfElse(optional<bool> isMultiLine) {
     enum Tag {
+        TAG_LIKELY,
+        TAG_UNLIKELY,
         TAG_CONDITION,
         TAG_THEN,
         TAG_ELSE
@@ -1709,6 +1993,17 @@ shared_ptr<Expression> Parser::matchExpressionIfElse(optional<bool> isMultiLine)
     ParseeResultsGroup resultsGroup = parseeResultsGroupForParsees(
         {
             Parsee::tokenParsee(TokenKind::IF, ParseeLevel::REQUIRED, false),
+            // @likely or @unlikely
+            Parsee::oneOfParsee(
+                {
+                    {
+                        Parsee::tokenParsee(TokenKind::M_LIKELY, ParseeLevel::REQUIRED, true, TAG_LIKELY)
+                    },
+                    {
+                        Parsee::tokenParsee(TokenKind::M_UNLIKELY, ParseeLevel::REQUIRED, true, TAG_UNLIKELY)
+                    }
+                }, ParseeLevel::OPTIONAL, true
+            ),
             Parsee::expressionParsee(ParseeLevel::CRITICAL, true, false, TAG_CONDITION),
             Parsee::oneOfParsee(ifElseParsees, parseeLevel, true)
         }
@@ -1720,9 +2015,16 @@ shared_ptr<Expression> Parser::matchExpressionIfElse(optional<bool> isMultiLine)
     shared_ptr<Expression> condition;
     shared_ptr<ExpressionBlock> thenBlock;
     shared_ptr<Expression> elseBlock;
+    optional<bool> isConditionLikely;
 
     for (ParseeResult &parseeResult : resultsGroup.getResults()) {
         switch (parseeResult.getTag()) {
+            case TAG_LIKELY:
+                isConditionLikely = true;
+                break;
+            case TAG_UNLIKELY:
+                isConditionLikely = false;
+                break;
             case TAG_CONDITION:
                 condition = parseeResult.getExpression();
                 break;
@@ -1735,7 +2037,7 @@ shared_ptr<Expression> Parser::matchExpressionIfElse(optional<bool> isMultiLine)
         }
     }
 
-    return make_shared<ExpressionIfElse>(condition, thenBlock, elseBlock, location);
+    return make_shared<ExpressionIfElse>(condition, thenBlock, elseBlock, isConditionLikely, location);
 }
 
 shared_ptr<Expression> Parser::matchExpressionBinary(shared_ptr<Expression> left) {
@@ -1816,11 +2118,13 @@ shared_ptr<Expression> Parser::matchExpressionBlock(vector<TokenKind> terminalTo
 shared_ptr<ValueType> Parser::matchValueType() {
     enum TAG {
         TAG_DATA,
+        TAG_VEC,
         TAG_BLOB,
         TAG_PROTO,
         TAG_BOXED,
         TAG_PTR_FUN,
         TAG_PTR,
+        TAG_ARGUMENT_REF,
         TAG_ARGUMENT_TYPE,
         TAG_RETURN_TYPE,
         TAG_TYPE,
@@ -1850,11 +2154,13 @@ shared_ptr<ValueType> Parser::matchValueType() {
                                             // colon
                                             Parsee::tokenParsee(TokenKind::COLON, ParseeLevel::REQUIRED, false),
                                             // first argument
+                                            Parsee::tokenParsee(TokenKind::REF, ParseeLevel::OPTIONAL, true, TAG_ARGUMENT_REF),
                                             Parsee::valueTypeParsee(ParseeLevel::REQUIRED, true, TAG_ARGUMENT_TYPE),
                                             // addditional arguments
                                             Parsee::repeatedGroupParsee(
                                                 {
                                                     Parsee::tokenParsee(TokenKind::COMMA, ParseeLevel::REQUIRED, false),
+                                                    Parsee::tokenParsee(TokenKind::REF, ParseeLevel::OPTIONAL, true, TAG_ARGUMENT_REF),
                                                     Parsee::valueTypeParsee(ParseeLevel::CRITICAL, true, TAG_ARGUMENT_TYPE)
                                                 }, ParseeLevel::OPTIONAL, true
                                             )
@@ -1889,6 +2195,15 @@ shared_ptr<ValueType> Parser::matchValueType() {
                         ),
                         Parsee::tokenParsee(TokenKind::RIGHT_ANGLE_BRACKET, ParseeLevel::CRITICAL, false)
                     },
+                    // VEC
+                    {
+                        Parsee::tokenParsee(TokenKind::VEC, ParseeLevel::REQUIRED, true, TAG_VEC),
+                        Parsee::tokenParsee(TokenKind::LEFT_ANGLE_BRACKET, ParseeLevel::CRITICAL, false),
+                        Parsee::valueTypeParsee(ParseeLevel::CRITICAL, true, TAG_SUBTYPE),
+                        Parsee::tokenParsee(TokenKind::COMMA, ParseeLevel::CRITICAL, false),
+                        Parsee::expressionParsee(ParseeLevel::CRITICAL, true, true, TAG_SIZE_EXPRESSION),
+                        Parsee::tokenParsee(TokenKind::RIGHT_ANGLE_BRACKET, ParseeLevel::CRITICAL, false)
+                    },
                     // BLOB
                     {
                         Parsee::tokenParsee(TokenKind::BLOB, ParseeLevel::REQUIRED, true, TAG_BLOB),
@@ -1957,11 +2272,13 @@ shared_ptr<ValueType> Parser::matchValueType() {
         return nullptr;
 
     bool isData = false;
+    bool isVec = false;
     bool isBlob = false;
     bool isProto = false;
     bool isBoxed = false;
     bool isPtrFun = false;
     bool isPtr = false;
+    bool isNextArgumentReference = false;
 
     vector<shared_ptr<ValueType>> argTypes;
     shared_ptr<ValueType> retType;
@@ -1977,6 +2294,9 @@ shared_ptr<ValueType> Parser::matchValueType() {
             case TAG_DATA:
                 isData = true;
                 break;
+            case TAG_VEC:
+                isVec = true;
+                break;
             case TAG_BLOB:
                 isBlob = true;
                 break;
@@ -1992,8 +2312,15 @@ shared_ptr<ValueType> Parser::matchValueType() {
             case TAG_PTR:
                 isPtr = true;
                 break;
+            case TAG_ARGUMENT_REF:
+                isNextArgumentReference = true;
+                break;
             case TAG_ARGUMENT_TYPE:
-                argTypes.push_back(parseeResult.getValueType());
+                if (isNextArgumentReference)
+                    argTypes.push_back(ValueType::reference(parseeResult.getValueType()));
+                else
+                    argTypes.push_back(parseeResult.getValueType());
+                isNextArgumentReference = false;
                 break;
             case TAG_RETURN_TYPE:
                 retType = parseeResult.getValueType();
@@ -2021,6 +2348,8 @@ shared_ptr<ValueType> Parser::matchValueType() {
 
     if (isData)
         return ValueType::data(subType, countExpression);
+    else if (isVec)
+        return ValueType::vec(subType, countExpression);
     else if (isBlob)
         return ValueType::blob(blobName, argTypes);
     else if (isProto)
@@ -24,14 +24,20 @@ class Parsee;
 class ParseeResult;
 class ParseeResultsGroup;
 
+#define MIN_CHUNK_TOKENS_COUNT 4096
+
 using namespace std;
 
 class Parser {
 private:
     vector<shared_ptr<Error>> errors;
     vector<shared_ptr<Token>> tokens;
+    int jobsCount;
     int currentIndex = 0;
 
+    optional<vector<shared_ptr<Statement>>> tryStatements();
+    optional<vector<shared_ptr<Statement>>> parallelStatements();
+
     // Statements
     shared_ptr<Statement> nextInBlockStatement();
 
@@ -105,7 +111,7 @@ private:
     void markError(optional<TokenKind> expectedTokenKind, optional<Parsee> expectedParsee, optional<string> message);
 
 public:
-    Parser(vector<shared_ptr<Token>> tokens);
+    Parser(vector<shared_ptr<Token>> tokens, int jobsCount);
     vector<shared_ptr<Statement>> getStatements();
 };
 
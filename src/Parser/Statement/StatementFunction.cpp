@@ -7,14 +7,20 @@
 
 StatementFunction::StatementFunction(
     bool shouldExport,
+    bool shouldInline,
+    bool isNoInline,
+    bool isHot,
+    bool isCold,
+    bool isPure,
     string name,
     vector<pair<string,
     shared_ptr<ValueType>>> arguments,
+    set<string> noAliasArgumentNames,
     shared_ptr<ValueType> returnValueType,
     shared_ptr<StatementBlock> statementBlock,
     shared_ptr<Location> location
 ):
-Statement(StatementKind::FUNCTION, location), shouldExport(shouldExport), name(name), arguments(arguments), returnValueType(returnValueType), statementBlock(statementBlock) {
+Statement(StatementKind::FUNCTION, location), shouldExport(shouldExport), shouldInline(shouldInline), isNoInline(isNoInline), isHot(isHot), isCold(isCold), isPure(isPure), name(name), arguments(arguments), noAliasArgumentNames(noAliasArgumentNames), returnValueType(returnValueType), statementBlock(statementBlock) {
     vector<shared_ptr<Statement>> statements = statementBlock->getStatements();
     if (!statements.empty() && statements.back()->getKind() == StatementKind::RETURN)
         return;
@@ -29,6 +35,26 @@ bool StatementFunction::getShouldExport() {
     return shouldExport;
 }
 
+bool StatementFunction::getShouldInline() {
+    return shouldInline;
+}
+
+bool StatementFunction::getIsNoInline() {
+    return isNoInline;
+}
+
+bool StatementFunction::getIsHot() {
+    return isHot;
+}
+
+bool StatementFunction::getIsCold() {
+    return isCold;
+}
+
+bool StatementFunction::getIsPure() {
+    return isPure;
+}
+
 string StatementFunction::getName() {
     return name;
 }
@@ -37,6 +63,10 @@ vector<pair<string, shared_ptr<ValueType>>> StatementFunction::getArguments() {
     return arguments;
 }
 
+set<string> StatementFunction::getNoAliasArgumentNames() {
+    return noAliasArgumentNames;
+}
+
 shared_ptr<ValueType> StatementFunction::getReturnValueType() {
     return returnValueType;
 }
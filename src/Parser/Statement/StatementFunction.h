@@ -1,6 +1,8 @@
 #ifndef STATEMENT_FUNCTION_H
 #define STATEMENT_FUNCTION_H
 
+#include <set>
+
 #include "Parser/Statement/Statement.h"
 
 class StatementBlock;
@@ -11,23 +13,41 @@ friend class Parser;
 
 private:
     bool shouldExport;
+    bool shouldInline;
+    bool isNoInline;
+    bool isHot;
+    bool isCold;
+    bool isPure;
     string name;
     vector<pair<string, shared_ptr<ValueType>>> arguments;
+    set<string> noAliasArgumentNames;
     shared_ptr<ValueType> returnValueType;
     shared_ptr<StatementBlock> statementBlock;
 
 public:
     StatementFunction(
         bool shouldExport,
+        bool shouldInline,
+        bool isNoInline,
+        bool isHot,
+        bool isCold,
+        bool isPure,
         string name,
         vector<pair<string, shared_ptr<ValueType>>> arguments,
+        set<string> noAliasArgumentNames,
         shared_ptr<ValueType> returnValueType,
         shared_ptr<StatementBlock> statementBlock,
         shared_ptr<Location> location
     );
     bool getShouldExport();
+    bool getShouldInline();
+    bool getIsNoInline();
+    bool getIsHot();
+    bool getIsCold();
+    bool getIsPure();
     string getName();
     vector<pair<string, shared_ptr<ValueType>>> getArguments();
+    set<string> getNoAliasArgumentNames();
     shared_ptr<ValueType> getReturnValueType();
     shared_ptr<ValueType> getValueType();
     shared_ptr<StatementBlock> getStatementBlock();
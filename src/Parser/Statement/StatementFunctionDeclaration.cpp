@@ -5,17 +5,43 @@
 
 StatementFunctionDeclaration::StatementFunctionDeclaration(
     bool shouldExport,
+    bool shouldInline,
+    bool isNoInline,
+    bool isHot,
+    bool isCold,
+    bool isPure,
     string name,
     vector<pair<string, shared_ptr<ValueType>>> arguments,
+    set<string> noAliasArgumentNames,
     shared_ptr<ValueType> returnValueType,
     shared_ptr<Location> location
 ):
-Statement(StatementKind::FUNCTION_DECLARATION, location), shouldExport(shouldExport), name(name), arguments(arguments), returnValueType(returnValueType) { }
+Statement(StatementKind::FUNCTION_DECLARATION, location), shouldExport(shouldExport), shouldInline(shouldInline), isNoInline(isNoInline), isHot(isHot), isCold(isCold), isPure(isPure), name(name), arguments(arguments), noAliasArgumentNames(noAliasArgumentNames), returnValueType(returnValueType) { }
 
 bool StatementFunctionDeclaration::getShouldExport() {
     return shouldExport;
 }
 
+bool StatementFunctionDeclaration::getShouldInline() {
+    return shouldInline;
+}
+
+bool StatementFunctionDeclaration::getIsNoInline() {
+    return isNoInline;
+}
+
+bool StatementFunctionDeclaration::getIsHot() {
+    return isHot;
+}
+
+bool StatementFunctionDeclaration::getIsCold() {
+    return isCold;
+}
+
+bool StatementFunctionDeclaration::getIsPure() {
+    return isPure;
+}
+
 string StatementFunctionDeclaration::getName() {
     return name;
 }
@@ -24,6 +50,10 @@ vector<pair<string, shared_ptr<ValueType>>> StatementFunctionDeclaration::getArg
     return arguments;
 }
 
+set<string> StatementFunctionDeclaration::getNoAliasArgumentNames() {
+    return noAliasArgumentNames;
+}
+
 shared_ptr<ValueType> StatementFunctionDeclaration::getReturnValueType() {
     return returnValueType;
 }
@@ -1,6 +1,8 @@
 #ifndef STATEMENT_FUNCTION_DECLARATION_H
 #define STATEMENT_FUNCTION_DECLARATION_H
 
+#include <set>
+
 #include "Statement.h"
 
 class ValueType;
@@ -10,21 +12,39 @@ friend class Parser;
 
 private:
     bool shouldExport;
+    bool shouldInline;
+    bool isNoInline;
+    bool isHot;
+    bool isCold;
+    bool isPure;
     string name;
     vector<pair<string, shared_ptr<ValueType>>> arguments;
+    set<string> noAliasArgumentNames;
     shared_ptr<ValueType> returnValueType;
 
 public:
     StatementFunctionDeclaration(
         bool shouldExport,
+        bool shouldInline,
+        bool isNoInline,
+        bool isHot,
+        bool isCold,
+        bool isPure,
         string name,
         vector<pair<string, shared_ptr<ValueType>>> arguments,
+        set<string> noAliasArgumentNames,
         shared_ptr<ValueType> returnValueType,
         shared_ptr<Location> location
     );
     bool getShouldExport();
+    bool getShouldInline();
+    bool getIsNoInline();
+    bool getIsHot();
+    bool getIsCold();
+    bool getIsPure();
     string getName();
     vector<pair<string, shared_ptr<ValueType>>> getArguments();
+    set<string> getNoAliasArgumentNames();
     shared_ptr<ValueType> getReturnValueType();
     shared_ptr<ValueType> getValueType();
 };
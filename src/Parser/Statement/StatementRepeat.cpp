@@ -9,6 +9,12 @@ StatementRepeat::StatementRepeat(
     shared_ptr<Expression> preConditionExpression,
     shared_ptr<Expression> postConditionExpression,
     shared_ptr<StatementBlock> bodyBlockStatement,
+    optional<int> unrollCount,
+    bool isNoUnroll,
+    optional<int> vectorizeWidth,
+    optional<int> interleaveCount,
+    bool isParallel,
+    optional<bool> isConditionLikely,
     shared_ptr<Location> location
 ):
 Statement(StatementKind::REPEAT, location),
@@ -16,7 +22,13 @@ initStatement(initStatement),
 postStatement(postStatement),
 preConditionExpression(preConditionExpression),
 postConditionExpression(postConditionExpression),
-bodyBlockStatement(bodyBlockStatement) { }
+bodyBlockStatement(bodyBlockStatement),
+unrollCount(unrollCount),
+isNoUnroll(isNoUnroll),
+vectorizeWidth(vectorizeWidth),
+interleaveCount(interleaveCount),
+isParallel(isParallel),
+isConditionLikely(isConditionLikely) { }
 
 shared_ptr<Statement> StatementRepeat::getInitStatement() {
     return initStatement;
@@ -37,3 +49,28 @@ shared_ptr<Expression> StatementRepeat::getPostConditionExpression() {
 shared_ptr<StatementBlock> StatementRepeat::getBodyBlockStatement() {
     return bodyBlockStatement;
 }
+
+
+optional<int> StatementRepeat::getUnrollCount() {
+    return unrollCount;
+}
+
+bool StatementRepeat::getIsNoUnroll() {
+    return isNoUnroll;
+}
+
+optional<int> StatementRepeat::getVectorizeWidth() {
+    return vectorizeWidth;
+}
+
+optional<int> StatementRepeat::getInterleaveCount() {
+    return interleaveCount;
+}
+
+bool StatementRepeat::getIsParallel() {
+    return isParallel;
+}
+
+optional<bool> StatementRepeat::getIsConditionLikely() {
+    return isConditionLikely;
+}
\ No newline at end of file
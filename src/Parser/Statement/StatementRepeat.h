@@ -1,6 +1,8 @@
 #ifndef STATEMENT_REPEAT
 #define STATEMENT_REPEAT
 
+#include <optional>
+
 #include "Statement.h"
 
 class Expression;
@@ -13,6 +15,13 @@ private:
     shared_ptr<Expression> preConditionExpression;
     shared_ptr<Expression> postConditionExpression;
     shared_ptr<StatementBlock> bodyBlockStatement;
+    // optimization hints
+    optional<int> unrollCount;
+    bool isNoUnroll;
+    optional<int> vectorizeWidth;
+    optional<int> interleaveCount;
+    bool isParallel;
+    optional<bool> isConditionLikely;
 
 public:
     StatementRepeat(
@@ -21,6 +30,12 @@ public:
         shared_ptr<Expression> preConditionExpression,
         shared_ptr<Expression> postConditionExpression,
         shared_ptr<StatementBlock> bodyBlockStatement,
+        optional<int> unrollCount,
+        bool isNoUnroll,
+        optional<int> vectorizeWidth,
+        optional<int> interleaveCount,
+        bool isParallel,
+        optional<bool> isConditionLikely,
         shared_ptr<Location> location
     );
     shared_ptr<Statement> getInitStatement();
@@ -28,6 +43,12 @@ public:
     shared_ptr<Expression> getPreConditionExpression();
     shared_ptr<Expression> getPostConditionExpression();
     shared_ptr<StatementBlock> getBodyBlockStatement();
+    optional<int> getUnrollCount();
+    bool getIsNoUnroll();
+    optional<int> getVectorizeWidth();
+    optional<int> getInterleaveCount();
+    bool getIsParallel();
+    optional<bool> getIsConditionLikely();
 };
 
 #endif
\ No newline at end of file
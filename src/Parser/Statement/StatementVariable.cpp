@@ -2,13 +2,25 @@
 
 #include "Parser/Expression/Expression.h"
 
-StatementVariable::StatementVariable(bool shouldExport, string identifier, shared_ptr<ValueType> valueType, shared_ptr<Expression> expression, shared_ptr<Location> location):
-Statement(StatementKind::VARIABLE, location), shouldExport(shouldExport), identifier(identifier), valueType(valueType), expression(expression) { }
+StatementVariable::StatementVariable(bool shouldExport, bool isConstant, bool isUninitialized, optional<int> alignment, string identifier, shared_ptr<ValueType> valueType, shared_ptr<Expression> expression, shared_ptr<Location> location):
+Statement(StatementKind::VARIABLE, location), shouldExport(shouldExport), isConstant(isConstant), isUninitialized(isUninitialized), alignment(alignment), identifier(identifier), valueType(valueType), expression(expression) { }
 
 bool StatementVariable::getShouldExport() {
     return shouldExport;
 }
 
+bool StatementVariable::getIsConstant() {
+    return isConstant;
+}
+
+bool StatementVariable::getIsUninitialized() {
+    return isUninitialized;
+}
+
+optional<int> StatementVariable::getAlignment() {
+    return alignment;
+}
+
 string StatementVariable::getIdentifier() {
     return identifier;
 }
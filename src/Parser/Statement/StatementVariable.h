@@ -1,6 +1,8 @@
 #ifndef STATEMENT_VARIABLE_H
 #define STATEMENT_VARIABLE_H
 
+#include <optional>
+
 #include "Statement.h"
 
 class Expression;
@@ -11,13 +13,19 @@ friend class Analyzer;
 
 private:
     bool shouldExport;
+    bool isConstant;
+    bool isUninitialized;
+    optional<int> alignment;
     string identifier;
     shared_ptr<ValueType> valueType;
     shared_ptr<Expression> expression;
 
 public:
-    StatementVariable(bool shouldExport, string identifier, shared_ptr<ValueType> valueType, shared_ptr<Expression> expression, shared_ptr<Location> location);
+    StatementVariable(bool shouldExport, bool isConstant, bool isUninitialized, optional<int> alignment, string identifier, shared_ptr<ValueType> valueType, shared_ptr<Expression> expression, shared_ptr<Location> location);
     bool getShouldExport();
+    bool getIsConstant();
+    bool getIsUninitialized();
+    optional<int> getAlignment();
     string getIdentifier();
     shared_ptr<ValueType> getValueType();
     shared_ptr<Expression> getExpression();
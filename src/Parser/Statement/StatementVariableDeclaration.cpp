@@ -1,16 +1,26 @@
 #include "StatementVariableDeclaration.h"
 
-StatementVariableDeclaration::StatementVariableDeclaration(bool shouldExport, string identifier, shared_ptr<ValueType> valueType, shared_ptr<Location> location):
-Statement(StatementKind::VARIABLE_DECLARATION, location), shouldExport(shouldExport), identifier(identifier), valueType(valueType) { }
+#include "Parser/Statement/StatementVariable.h"
+
+StatementVariableDeclaration::StatementVariableDeclaration(bool shouldExport, bool isConstant, string identifier, shared_ptr<ValueType> valueType, shared_ptr<StatementVariable> constantStatement, shared_ptr<Location> location):
+Statement(StatementKind::VARIABLE_DECLARATION, location), shouldExport(shouldExport), isConstant(isConstant), identifier(identifier), valueType(valueType), constantStatement(constantStatement) { }
 
 bool StatementVariableDeclaration::getShouldExport() {
     return shouldExport;
 }
 
+bool StatementVariableDeclaration::getIsConstant() {
+    return isConstant;
+}
+
 string StatementVariableDeclaration::getIdentifier() {
     return identifier;
 }
 
 shared_ptr<ValueType> StatementVariableDeclaration::getValueType() {
     return valueType;
+}
+
+shared_ptr<StatementVariable> StatementVariableDeclaration::getConstantStatement() {
+    return constantStatement;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Statement.h"
 
+class StatementVariable;
 class ValueType;
 
 class StatementVariableDeclaration: public Statement {
@@ -10,14 +11,19 @@ friend class Analyzer;
 
 private:
     bool shouldExport;
+    bool isConstant;
     string identifier;
     shared_ptr<ValueType> valueType;
+    // definition of a constant, so its value can be folded by the importers
+    shared_ptr<StatementVariable> constantStatement;
 
 public:
-    StatementVariableDeclaration(bool shouldExport, string identifier, shared_ptr<ValueType> valueType, shared_ptr<Location> location);
+    StatementVariableDeclaration(bool shouldExport, bool isConstant, string identifier, shared_ptr<ValueType> valueType, shared_ptr<StatementVariable> constantStatement, shared_ptr<Location> location);
     bool getShouldExport();
+    bool getIsConstant();
     string getIdentifier();
     shared_ptr<ValueType> getValueType();
+    shared_ptr<StatementVariable> getConstantStatement();
 };
 
 #endif
\ No newline at end of file
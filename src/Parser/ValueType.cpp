@@ -84,6 +84,14 @@ shared_ptr<ValueType> ValueType::data(shared_ptr<ValueType> subType, shared_ptr<
     return valueType;
 }
 
+shared_ptr<ValueType> ValueType::vec(shared_ptr<ValueType> subType, shared_ptr<Expression> countExpression) {
+    shared_ptr<ValueType> valueType = make_shared<ValueType>();
+    valueType->kind = ValueTypeKind::VEC;
+    valueType->subType = subType;
+    valueType->countExpression = countExpression;
+    return valueType;
+}
+
 shared_ptr<ValueType> ValueType::blob(string blobName, optional<vector<shared_ptr<ValueType>>> namedTypeValues) {
     shared_ptr<ValueType> valueType = make_shared<ValueType>();
     valueType->kind = ValueTypeKind::BLOB;
@@ -139,6 +147,19 @@ shared_ptr<ValueType> ValueType::namedType(string namedTypeKey) {
     return valueType;
 }
 
+shared_ptr<ValueType> ValueType::reference(shared_ptr<ValueType> referencedType) {
+    shared_ptr<ValueType> valueType = make_shared<ValueType>(*referencedType);
+    valueType->isReferenceArgument = true;
+    return valueType;
+}
+
+shared_ptr<ValueType> ValueType::constant(shared_ptr<ValueType> constantType) {
+    // read-only just like a reference, but also placed in read-only memory
+    shared_ptr<ValueType> valueType = reference(constantType);
+    valueType->isConstantVariable = true;
+    return valueType;
+}
+
 ValueType::ValueType() { }
 ValueType::ValueType(ValueTypeKind kind):
 kind(kind) { }
@@ -242,6 +263,12 @@ bool ValueType::isEqual(shared_ptr<ValueType> other) {
 
             return thisSize == thatSize;
         }
+        case ValueTypeKind::VEC: {
+            // lanes count is always known
+            if (!other->isVec() || !subType->isEqual(other->getSubType()))
+                return false;
+            return getValueArg() == other->getValueArg();
+        }
         case ValueTypeKind::BLOB: {
             if (!other->isBlob())
                 return false;
@@ -259,10 +286,12 @@ bool ValueType::isEqual(shared_ptr<ValueType> other) {
             if ((*argumentTypes).size() != (*other->getArgumentTypes()).size())
                 return false;
 
-            // do argument types match?
+            // do argument types and modes match?
             for (int i=0; i<(*argumentTypes).size(); i++) {
                 if (!(*argumentTypes).at(i)->isEqual((*other->getArgumentTypes()).at(i)))
                     return false;
+                if ((*argumentTypes).at(i)->isReference() != (*other->getArgumentTypes()).at(i)->isReference())
+                    return false;
             }
 
             // do the return types match?
@@ -417,6 +446,10 @@ bool ValueType::isDataNumeric() {
     return false;
 }
 
+bool ValueType::isVec() {
+    return kind == ValueTypeKind::VEC;
+}
+
 bool ValueType::isAddress() {
     return kind == ValueTypeKind::A;
 }
@@ -452,3 +485,11 @@ bool ValueType::isNamedType() {
 bool ValueType::isBoxedNamedType() {
     return kind == ValueTypeKind::BOXED && subType->isNamedType();
 }
+
+bool ValueType::isReference() {
+    return isReferenceArgument;
+}
+
+bool ValueType::isConstant() {
+    return isConstantVariable;
+}
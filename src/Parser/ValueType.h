@@ -35,6 +35,7 @@ enum class ValueTypeKind {
     PTR,
 
     DATA,
+    VEC,
     BLOB,
     PROTO,
     BOXED,
@@ -60,6 +61,8 @@ private:
     optional<string> namedTypeKey;
     optional<vector<string>> namedTypeKeys;
     optional<vector<shared_ptr<ValueType>>> namedTypeValues;
+    bool isReferenceArgument = false;
+    bool isConstantVariable = false;
 
 public:
     static shared_ptr<ValueType> NONE;
@@ -81,6 +84,7 @@ public:
 
     static shared_ptr<ValueType> simpleForToken(shared_ptr<Token> token);
     static shared_ptr<ValueType> data(shared_ptr<ValueType> subType, shared_ptr<Expression> countExpression);
+    static shared_ptr<ValueType> vec(shared_ptr<ValueType> subType, shared_ptr<Expression> countExpression);
     static shared_ptr<ValueType> blob(string blobName, optional<vector<shared_ptr<ValueType>>> namedTypeValues);
     static shared_ptr<ValueType> proto(string protoName);
     static shared_ptr<ValueType> boxed(shared_ptr<ValueType> subType);
@@ -88,14 +92,16 @@ public:
     static shared_ptr<ValueType> ptr(shared_ptr<ValueType> subType);
     static shared_ptr<ValueType> composite(vector<shared_ptr<ValueType>> elementTypes, shared_ptr<Expression> countExpression);
     static shared_ptr<ValueType> namedType(string namedTypeKey);
+    static shared_ptr<ValueType> reference(shared_ptr<ValueType> referencedType);
+    static shared_ptr<ValueType> constant(shared_ptr<ValueType> constantType);
 
     ValueType();
     ValueType(ValueTypeKind kind);
 
     ValueTypeKind getKind();
-    // data, pointer, boxed
+    // data, vec, pointer, boxed
     shared_ptr<ValueType> getSubType();
-    // data
+    // data, vec
     int getValueArg(); // TODO: remove
     shared_ptr<Expression> getCountExpression();
     // function
@@ -125,6 +131,8 @@ public:
     bool isDataBool();
     bool isDataNumeric();
 
+    bool isVec();
+
     bool isAddress();
     bool isPointer();
     bool isFunction();
@@ -134,6 +142,8 @@ public:
     bool isComposite();
     bool isNamedType();
     bool isBoxedNamedType();
+    bool isReference();
+    bool isConstant();
 };
 
 #endif
\ No newline at end of file
@@ -5,8 +5,10 @@
 
 #include <llvm/Support/CommandLine.h>
 
+#include "Module/BlobSpecializations.h"
 #include "Module/Module.h"
 #include "Module/ModulesStore.h"
+#include "Module/ModuleReachability.h"
 
 #include "Lexer/Token.h"
 #include "Lexer/Lexer.h"
@@ -15,6 +17,7 @@
 #include "Parser/Statement/Statement.h"
 
 #include "Analyzer/Analyzer.h"
+#include "Analyzer/AnalyzerScope.h"
 
 #include "ModuleBuilder/ModuleBuilder.h"
 #include "CodeGenerator/CodeGenerator.h"
@@ -87,6 +90,42 @@ int main(int argc, char **argv) {
         llvm::cl::cat(mainOptions)
     );
 
+    // lazy compilation
+    llvm::cl::opt<bool> isLazy(
+        "lazy",
+        llvm::cl::desc("Only analyze and build functions reachable from main and the exported symbols"),
+        llvm::cl::cat(mainOptions)
+    );
+
+    // generic blobs specialization
+    llvm::cl::opt<bool> isMono(
+        "mono",
+        llvm::cl::desc("Build a separate copy of the generic blobs for each set of type arguments"),
+        llvm::cl::cat(mainOptions)
+    );
+
+    // type-based alias analysis
+    llvm::cl::opt<bool> isNoTbaa(
+        "no-tbaa",
+        llvm::cl::desc("Don't tell the optimizer that values of different types never overlap in memory"),
+        llvm::cl::cat(mainOptions)
+    );
+
+    // integer overflow
+    llvm::cl::opt<bool> isWrapping(
+        "wrap",
+        llvm::cl::desc("Integer arithmetic wraps around on overflow instead of being undefined"),
+        llvm::cl::cat(mainOptions)
+    );
+
+    // analysis threads
+    llvm::cl::opt<int> jobsCount(
+        "jobs",
+        llvm::cl::desc("Number of threads used for parsing and checking function bodies"),
+        llvm::cl::init(1),
+        llvm::cl::cat(mainOptions)
+    );
+
     // input files
     llvm::cl::list<string> inputFileNames(
         llvm::cl::Positional,
@@ -174,7 +213,8 @@ int main(int argc, char **argv) {
         llvm::cl::values(
             clEnumValN(CodeGenerator::Options::FUNCTION_SECTIONS, "function-sections", "Place each function in its own section"),
             clEnumValN(CodeGenerator::Options::NO_BSS, "no-zero-initialized-in-bss", "Don't place zero initialized data in BSS"),
-            clEnumValN(CodeGenerator::Options::STACK_SIZES, "stack-sizes", "Provide used stack information per function. Readable with llvm-readobj --stack-sizes")
+            clEnumValN(CodeGenerator::Options::STACK_SIZES, "stack-sizes", "Provide used stack information per function. Readable with llvm-readobj --stack-sizes"),
+            clEnumValN(CodeGenerator::Options::LOOP_REMARKS, "loop-remarks", "Report which loops were unrolled or vectorized and which hints couldn't be applied")
         ),
         llvm::cl::cat(targetOptions)
     );
@@ -233,7 +273,7 @@ int main(int argc, char **argv) {
             cout << format("🧸 Parsing \"{}\"", inputFileNames[i]) << endl;
 
         timeStamp = clock();
-        Parser parser(tokens);
+        Parser parser(tokens, max((int)jobsCount, 1));
         modulesStore.appendStatements(parser.getStatements());
 
         timeStamp = clock() - timeStamp;
@@ -242,7 +282,21 @@ int main(int argc, char **argv) {
             cout << format("⏱️ Parsed \"{}\" in {:.6f} seconds", inputFileNames[i], (float)timeStamp / CLOCKS_PER_SEC) << endl << endl;
     }
 
+    // Reachability
+    map<string, shared_ptr<ModuleReachability>> reachabilitiesMap;
+    if (isLazy) {
+        for (shared_ptr<Module> module : modulesStore.getModules())
+            reachabilitiesMap[module->getName()] = make_shared<ModuleReachability>(module);
+    }
+
+    // Type arguments of generic blobs, collected during analysis and built by the defining modules
+    shared_ptr<BlobSpecializations> blobSpecializations;
+    if (isMono)
+        blobSpecializations = make_shared<BlobSpecializations>();
+
     // Analysis
+    // exported headers are checked once and shared between the modules
+    shared_ptr<map<string, shared_ptr<AnalyzerScope>>> importedScopesMap = make_shared<map<string, shared_ptr<AnalyzerScope>>>();
     for (shared_ptr<Module> module : modulesStore.getModules()) {
         time_t timeStamp;
 
@@ -250,7 +304,7 @@ int main(int argc, char **argv) {
             cout << format("🔮 Analyzing module \"{}\"", module->getName()) << endl;
 
         timeStamp = clock();
-        Analyzer typesAnalyzer(module, modulesStore.getExportedHeaderStatementsMap());
+        Analyzer typesAnalyzer(module, modulesStore.getExportedHeaderStatementsMap(), importedScopesMap, reachabilitiesMap[module->getName()], blobSpecializations, max((int)jobsCount, 1));
         typesAnalyzer.checkModule();
         timeStamp = clock() - timeStamp;
         totalAnalysisTime += timeStamp;
@@ -286,8 +340,13 @@ int main(int argc, char **argv) {
             codeGenerator.getPointerSize(),
             codeGenerator.getArchType(),
             codeGenerator.getCallingConvetion(),
+            codeGenerator.getDataLayout(),
             module,
-            modulesStore.getExportedHeaderStatementsMap()
+            modulesStore.getExportedHeaderStatementsMap(),
+            reachabilitiesMap[module->getName()],
+            blobSpecializations,
+            !isNoTbaa,
+            isWrapping
         );
         shared_ptr<llvm::Module> llvmModule = moduleBuilder.getLlvmModule();
         timeStamp = clock() - timeStamp;
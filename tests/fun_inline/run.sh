@@ -0,0 +1,12 @@
+#!/bin/bash
+
+SCRIPT_PATH="$(readlink -f "${BASH_SOURCE}")"
+SCRIPT_DIR="$(dirname "${SCRIPT_PATH}")"
+source "${SCRIPT_DIR}/../lib.sh"
+
+brb "${SCRIPT_DIR}/math.brc" "${SCRIPT_DIR}/main.brc" &&
+cc -o ${TEST_NAME} Math.o main.o &&
+./${TEST_NAME}
+
+[ ${?} = 123 ]
+check_test ${TEST_NAME} ${?}
\ No newline at end of file
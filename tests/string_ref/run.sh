@@ -0,0 +1,12 @@
+#!/bin/bash
+
+SCRIPT_PATH="$(readlink -f "${BASH_SOURCE}")"
+SCRIPT_DIR="$(dirname "${SCRIPT_PATH}")"
+source "${SCRIPT_DIR}/../lib.sh"
+
+brb "${SCRIPT_DIR}/main.brc" "${SCRIPT_DIR}/../../lib/B/String.brc" "${SCRIPT_DIR}/../../lib/BSys.brc" &&
+cc -o ${TEST_NAME} main.o B.o BSys.o &&
+./${TEST_NAME}
+
+[ ${?} = 123 ]
+check_test ${TEST_NAME} ${?}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#!/bin/bash
+
+SCRIPT_PATH="$(readlink -f "${BASH_SOURCE}")"
+SCRIPT_DIR="$(dirname "${SCRIPT_PATH}")"
+source "${SCRIPT_DIR}/../lib.sh"
+
+# both have to be rejected
+! brb "${SCRIPT_DIR}/member_call.brc" &&
+! brb "${SCRIPT_DIR}/address.brc"
+
+check_test ${TEST_NAME} ${?}
\ No newline at end of file